@@ -0,0 +1,24 @@
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <poll.h>
+
+int main(void)
+{
+  int fd[2];
+  struct pollfd p;
+  pid_t pid;
+  volatile long *x = (volatile long *) mmap(NULL, sizeof(long),
+                       PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if (x == MAP_FAILED || pipe(fd)) return 1;
+  *x = 0;
+  pid = fork();
+  if (pid < 0) return 1;
+  if (!pid) { *x = 1; __sync_synchronize(); _exit(0); }
+  p.fd = fd[0]; p.events = POLLIN;
+  (void)poll(&p, 1, 0);
+  waitpid(pid, NULL, 0);
+  return *x != 1;
+}
@@ -1325,6 +1325,7 @@ F2xq_log_Coppersmith(long nbrel, long r, long n, GEN T)
     long j, l;
     u[2] = i;
     mt_queue_submit(&pt, 0, running ? mkvec2(u, stoi(i)): NULL);
+    if (running) i++;
     done = mt_queue_get(&pt, NULL, &pending);
     if (!done) continue;
     L = gel(done, 2); nbtest += itos(gel(done,1));
@@ -1340,7 +1341,6 @@ F2xq_log_Coppersmith(long nbrel, long r, long n, GEN T)
       }
     }
     if (rel>nbrel) stop=1;
-    i++;
   }
   mt_queue_end(&pt);
   if (DEBUGLEVEL) err_printf(": %ld tests\n", nbtest);
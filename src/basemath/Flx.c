@@ -2392,15 +2392,47 @@ FlvV_polint_tree(GEN T, GEN R, GEN s, GEN xa, GEN ya, ulong p, long vs)
   return gerepileuptoleaf(av, gmael(Tp,m,1));
 }
 
+static GEN
+Flx_Flv_eval(GEN P, GEN xa, ulong p)
+{
+  long i, l = lg(xa);
+  GEN R = cgetg(l, t_VECSMALL);
+  for (i=1; i<l; i++) R[i] = Flx_eval(P, xa[i], p);
+  return R;
+}
+
 GEN
 Flx_Flv_multieval(GEN P, GEN xa, ulong p)
 {
   pari_sp av = avma;
-  GEN s = producttree_scheme(lg(xa)-1);
-  GEN T = Flv_producttree(xa, s, p, P[1]);
+  GEN s, T;
+  if (minss(lgpol(P), lg(xa)-1) < Flx_MULTIEVAL_LIMIT)
+    return Flx_Flv_eval(P, xa, p);
+  s = producttree_scheme(lg(xa)-1);
+  T = Flv_producttree(xa, s, p, P[1]);
   return gerepileuptoleaf(av, Flx_Flv_multieval_tree(P, xa, T, p));
 }
 
+/* P a vector of Flx; return [Flx_Flv_multieval(P[i], xa, p), i=1..#P],
+ * sharing the product tree */
+GEN
+FlxV_Flv_multieval(GEN P, GEN xa, ulong p)
+{
+  pari_sp av = avma;
+  long i, l = lg(P), n = 0;
+  GEN s, T, M = cgetg(l, t_VEC);
+  for (i=1; i<l; i++) n = maxss(n, lgpol(gel(P,i)));
+  if (minss(n, lg(xa)-1) < Flx_MULTIEVAL_LIMIT)
+  {
+    for (i=1; i<l; i++) gel(M,i) = Flx_Flv_eval(gel(P,i), xa, p);
+    return M;
+  }
+  s = producttree_scheme(lg(xa)-1);
+  T = Flv_producttree(xa, s, p, 0);
+  for (i=1; i<l; i++) gel(M,i) = Flx_Flv_multieval_tree(gel(P,i), xa, T, p);
+  return gerepilecopy(av, M);
+}
+
 GEN
 Flv_polint(GEN xa, GEN ya, ulong p, long vs)
 {
@@ -3836,6 +3868,26 @@ FlxY_evalx(GEN Q, ulong x, ulong p)
   return Flx_renormalize(z, lb);
 }
 
+/* [FlxY_evalx(Q, x[j], p), j=1..#x], evaluating all coefficients of Q at
+ * once through FlxV_Flv_multieval */
+GEN
+FlxY_Flv_evalx(GEN Q, GEN x, ulong p)
+{
+  pari_sp av = avma;
+  long i, j, lb = lg(Q), l = lg(x), vs = evalvarn(varn(Q));
+  GEN V, z, C = cgetg(lb-1, t_VEC);
+  for (i=2; i<lb; i++) gel(C,i-1) = gel(Q,i);
+  V = FlxV_Flv_multieval(C, x, p);
+  z = cgetg(l, t_VEC);
+  for (j=1; j<l; j++)
+  {
+    GEN c = cgetg(lb, t_VECSMALL); c[1] = vs;
+    for (i=2; i<lb; i++) c[i] = mael(V,i-1,j);
+    gel(z,j) = Flx_renormalize(c, lb);
+  }
+  return gerepileupto(av, z);
+}
+
 GEN
 FlxY_Flx_translate(GEN P, GEN c, ulong p)
 {
@@ -1254,16 +1254,30 @@ closest_lift(GEN a, GEN b, GEN h)
   return addii(a, mulii(b, diviiround(subii(h,a), b)));
 }
 
+/* P + Q, x(P) != x(Q), given u = 1/(x(Q)-x(P)) */
+static GEN
+FlxqE_add_inv(GEN P, GEN Q, GEN u, GEN a4, GEN T, ulong p)
+{
+  GEN Px = gel(P,1), Py = gel(P,2), Qx = gel(Q,1), Qy = gel(Q,2);
+  GEN slope = Flxq_mul(Flx_sub(Qy, Py, p), u, T, p), R = cgetg(3,t_VEC);
+  gel(R, 1) = Flx_sub(Flx_sub(Flxq_sqr(slope, T, p), Px, p), Qx, p);
+  if (typ(a4)==t_VEC) gel(R, 1) = Flx_sub(gel(R, 1),gel(a4, 1), p);
+  gel(R, 2) = Flx_sub(Flxq_mul(slope, Flx_sub(Px, gel(R, 1), p), T, p), Py, p);
+  return R;
+}
+
 static GEN
 FlxqE_find_order(GEN f, GEN h, GEN bound, GEN B, GEN a4, GEN T, ulong p)
 {
   pari_sp av = avma, av1;
   pari_timer Ti;
   long s = itos( gceil(gsqrt(gdiv(bound,B),DEFAULTPREC)) ) >> 1;
-  GEN tx, ti;
+  GEN tx, ti, pts, u;
   GEN fh = FlxqE_mul(f, h, a4, T, p);
   GEN F, P = fh, fg;
-  long i;
+  const struct bb_field *ff;
+  void *E;
+  long i, j, nb;
   if (DEBUGLEVEL >= 6) timer_start(&Ti);
   if (ell_is_inf(fh)) return h;
   F = FlxqE_mul(f, B, a4, T, p);
@@ -1280,21 +1294,52 @@ FlxqE_find_order(GEN f, GEN h, GEN bound, GEN B, GEN a4, GEN T, ulong p)
   }
   tx = cgetg(s+1,t_VECSMALL);
   /* Baby Step/Giant Step */
-  av1 = avma;
-  for (i=1; i<=s; i++)
+  nb = minss(128, s >> 1); /* > 0. Will do nb pts at a time: faster inverse */
+  pts = cgetg(nb+1, t_VEC);
+  u = cgetg(nb+1, t_VEC);
+  ff = get_Flxq_field(&E, T, p);
+  for (i=1; i<=nb; i++)
   { /* baby steps */
+    gel(pts,i) = P; /* h.f + (i-1).F */
     tx[i] = hash_GEN(gel(P, 1));
     P = FlxqE_add(P, F, a4, T, p); /* h.f + i.F */
     if (ell_is_inf(P)) return gerepileupto(av, addii(h, mului(i,B)));
+  }
+  fg = FlxqE_sub(P, fh, a4, T, p); /* nb.F */
+  if (ell_is_inf(fg)) return gerepileupto(av, mului(nb,B));
+  av1 = avma; /* more baby steps, nb points at a time */
+  while (i <= s)
+  {
+    long maxj = minss(nb, s-i+1);
+    GEN v;
+    for (j=1; j<=maxj; j++)
+    {
+      P = gel(pts,j); /* h.f + (i-nb+j-2).F */
+      gel(u,j) = Flx_sub(gel(fg,1), gel(P,1), p);
+      if (!lgpol(gel(u,j))) /* sum = 0 or doubling */
+      {
+        long k = i+j-2;
+        if (Flx_equal(gel(P,2), gel(fg,2))) k -= 2*nb; /* fg == P */
+        return gerepileupto(av, addii(h, mulsi(k,B)));
+      }
+    }
+    setlg(u, maxj+1); v = gen_V_inv(u, E, ff); setlg(u, nb+1);
+    for (j=1; j<=maxj; j++,i++)
+    {
+      P = FlxqE_add_inv(gel(pts,j), fg, gel(v,j), a4, T, p); /* h.f+(i-1).F */
+      gel(pts,j) = P; tx[i] = hash_GEN(gel(P, 1));
+    }
     if (gc_needed(av1,3))
     {
       if(DEBUGMEM>1) pari_warn(warnmem,"[Flxq_ellcard] baby steps, i=%ld",i);
-      P = gerepileupto(av1,P);
+      gerepileall(av1, 2, &pts, &P);
     }
   }
   if (DEBUGLEVEL >= 6) timer_printf(&Ti, "[Flxq_ellcard] baby steps, s = %ld",s);
   /* giant steps: fg = s.F */
-  fg = gerepileupto(av1, FlxqE_sub(P, fh, a4, T, p));
+  P = FlxqE_sub(P, fh, a4, T, p); /* (s-1).F */
+  if (ell_is_inf(P)) return gerepileupto(av,mului(s-1,B));
+  fg = FlxqE_add(P, F, a4, T, p);
   if (ell_is_inf(fg)) return gerepileupto(av,mului(s,B));
   ti = vecsmall_indexsort(tx); /* = permutation sorting tx */
   tx = perm_mul(tx,ti);
@@ -1309,7 +1354,7 @@ FlxqE_find_order(GEN f, GEN h, GEN bound, GEN B, GEN a4, GEN T, ulong p)
       while (r && tx[r] == k) r--;
       for (r++; r <= s && tx[r] == k; r++)
       {
-        long j = ti[r]-1;
+        j = ti[r]-1;
         GEN Q = FlxqE_add(FlxqE_mul(F, stoi(j), a4, T, p), fh, a4, T, p);
         if (DEBUGLEVEL >= 6)
           timer_printf(&Ti, "[Flxq_ellcard] giant steps, i = %ld",i);
@@ -990,6 +990,7 @@ FpV_inv(GEN x, GEN p)
   long i, lx = lg(x);
   GEN u, y = cgetg(lx, t_VEC);
 
+  if (lx == 1) return y;
   gel(y,1) = gel(x,1);
   for (i=2; i<lx; i++) gel(y,i) = Fp_mul(gel(y,i-1), gel(x,i), p);
 
@@ -1007,6 +1008,7 @@ FqV_inv(GEN x, GEN T, GEN p)
   long i, lx = lg(x);
   GEN u, y = cgetg(lx, t_VEC);
 
+  if (lx == 1) return y;
   gel(y,1) = gel(x,1);
   for (i=2; i<lx; i++) gel(y,i) = Fq_mul(gel(y,i-1), gel(x,i), T,p);
 
@@ -1391,15 +1393,47 @@ FpVV_polint_tree(GEN T, GEN R, GEN s, GEN xa, GEN ya, GEN p, long vs)
   return gerepilecopy(av, gmael(Tp,m,1));
 }
 
+static GEN
+FpX_FpV_eval(GEN P, GEN xa, GEN p)
+{
+  long i, l = lg(xa);
+  GEN R = cgetg(l, t_VEC);
+  for (i=1; i<l; i++) gel(R,i) = FpX_eval(P, gel(xa,i), p);
+  return R;
+}
+
 GEN
 FpX_FpV_multieval(GEN P, GEN xa, GEN p)
 {
   pari_sp av = avma;
-  GEN s = producttree_scheme(lg(xa)-1);
-  GEN T = FpV_producttree(xa, s, p, varn(P));
+  GEN s, T;
+  if (minss(lgpol(P), lg(xa)-1) < FpX_MULTIEVAL_LIMIT)
+    return gerepileupto(av, FpX_FpV_eval(P, xa, p));
+  s = producttree_scheme(lg(xa)-1);
+  T = FpV_producttree(xa, s, p, varn(P));
   return gerepileupto(av, FpX_FpV_multieval_tree(P, xa, T, p));
 }
 
+/* P a vector of FpX; return [FpX_FpV_multieval(P[i], xa, p), i=1..#P],
+ * sharing the product tree */
+GEN
+FpXV_FpV_multieval(GEN P, GEN xa, GEN p)
+{
+  pari_sp av = avma;
+  long i, l = lg(P), n = 0;
+  GEN s, T, M = cgetg(l, t_VEC);
+  for (i=1; i<l; i++) n = maxss(n, lgpol(gel(P,i)));
+  if (minss(n, lg(xa)-1) < FpX_MULTIEVAL_LIMIT)
+  {
+    for (i=1; i<l; i++) gel(M,i) = FpX_FpV_eval(gel(P,i), xa, p);
+    return gerepilecopy(av, M);
+  }
+  s = producttree_scheme(lg(xa)-1);
+  T = FpV_producttree(xa, s, p, 0);
+  for (i=1; i<l; i++) gel(M,i) = FpX_FpV_multieval_tree(gel(P,i), xa, T, p);
+  return gerepilecopy(av, M);
+}
+
 GEN
 FpV_polint(GEN xa, GEN ya, GEN p, long vs)
 {
@@ -1505,6 +1539,28 @@ FpXQ_div(GEN x,GEN y,GEN T,GEN p)
   return gerepileupto(av, FpXQ_mul(x,FpXQ_inv(y,T,p),T,p));
 }
 
+/* invert all elements of x using Montgomery's multi-inverse trick.
+ * Not stack-clean. */
+GEN
+FpXQV_inv(GEN x, GEN T, GEN p)
+{
+  long i, lx = lg(x);
+  GEN u, y = cgetg(lx, t_VEC);
+
+  if (lx == 1) return y;
+  T = FpX_get_red(T, p);
+  gel(y,1) = gel(x,1);
+  for (i=2; i<lx; i++) gel(y,i) = FpXQ_mul(gel(y,i-1), gel(x,i), T,p);
+
+  u = FpXQ_inv(gel(y,--i), T,p);
+  for ( ; i > 1; i--)
+  {
+    gel(y,i) = FpXQ_mul(u, gel(y,i-1), T,p);
+    u = FpXQ_mul(u, gel(x,i), T,p); /* u = 1 / (x[1] ... x[i-1]) */
+  }
+  gel(y,1) = u; return y;
+}
+
 static GEN
 _FpXQ_add(void *data, GEN x, GEN y)
 {
@@ -1044,6 +1044,146 @@ FpXQXV_prod(GEN V, GEN T, GEN p)
   }
 }
 
+/* xa a vector of Fq */
+static GEN
+FpXQV_producttree(GEN xa, GEN s, GEN T, GEN p, long vs)
+{
+  long n = lg(xa)-1;
+  long m = n==1 ? 1: expu(n-1)+1;
+  long i, j, k, ls = lg(s);
+  GEN Tr = cgetg(m+1, t_VEC);
+  GEN t = cgetg(ls, t_VEC);
+  for (j=1, k=1; j<ls; k+=s[j++])
+    gel(t, j) = s[j] == 1 ?
+             deg1pol(gen_1, Fq_neg(gel(xa,k), T, p), vs):
+             mkpoln(3, gen_1,
+               Fq_neg(Fq_add(gel(xa,k), gel(xa,k+1), T, p), T, p),
+               Fq_mul(gel(xa,k), gel(xa,k+1), T, p));
+  for (j=1; j<ls; j++) setvarn(gel(t,j), vs);
+  gel(Tr,1) = t;
+  for (i=2; i<=m; i++)
+  {
+    GEN u = gel(Tr, i-1);
+    long n = lg(u)-1;
+    GEN t = cgetg(((n+1)>>1)+1, t_VEC);
+    for (j=1, k=1; k<n; j++, k+=2)
+      gel(t, j) = FpXQX_mul(gel(u, k), gel(u, k+1), T, p);
+    gel(Tr, i) = t;
+  }
+  return Tr;
+}
+
+static GEN
+FpXQX_FpXQV_multieval_tree(GEN P, GEN xa, GEN Tr, GEN T, GEN p)
+{
+  pari_sp av = avma;
+  long i,j,k;
+  long m = lg(Tr)-1;
+  GEN t;
+  GEN Tp = cgetg(m+1, t_VEC);
+  gel(Tp, m) = mkvec(P);
+  for (i=m-1; i>=1; i--)
+  {
+    GEN u = gel(Tr, i);
+    GEN v = gel(Tp, i+1);
+    long n = lg(u)-1;
+    t = cgetg(n+1, t_VEC);
+    for (j=1, k=1; k<n; j++, k+=2)
+    {
+      gel(t, k)   = FpXQX_rem(gel(v, j), gel(u, k), T, p);
+      gel(t, k+1) = FpXQX_rem(gel(v, j), gel(u, k+1), T, p);
+    }
+    gel(Tp, i) = t;
+  }
+  {
+    GEN R = cgetg(lg(xa), t_VEC);
+    GEN u = gel(Tr, i+1);
+    GEN v = gel(Tp, i+1);
+    long n = lg(u)-1;
+    for (j=1, k=1; j<=n; j++)
+    {
+      long c, d = degpol(gel(u,j));
+      for (c=1; c<=d; c++, k++)
+        gel(R,k) = FqX_eval(gel(v, j), gel(xa,k), T, p);
+    }
+    return gerepileupto(av, R);
+  }
+}
+
+static GEN
+FpXQVV_polint_tree(GEN Tr, GEN R, GEN s, GEN xa, GEN ya, GEN T, GEN p, long vs)
+{
+  pari_sp av = avma;
+  long m = lg(Tr)-1;
+  long i, j, k, ls = lg(s);
+  GEN Tp = cgetg(m+1, t_VEC);
+  GEN t = cgetg(ls, t_VEC);
+  for (j=1, k=1; j<ls; k+=s[j++])
+    if (s[j]==2)
+    {
+      GEN a = Fq_mul(gel(ya,k), gel(R,k), T, p);
+      GEN b = Fq_mul(gel(ya,k+1), gel(R,k+1), T, p);
+      gel(t, j) = deg1pol(Fq_add(a, b, T, p),
+              Fq_neg(Fq_add(Fq_mul(gel(xa,k), b, T, p),
+              Fq_mul(gel(xa,k+1), a, T, p), T, p), T, p), vs);
+    }
+    else
+      gel(t, j) = scalarpol(Fq_mul(gel(ya,k), gel(R,k), T, p), vs);
+  gel(Tp, 1) = t;
+  for (i=2; i<=m; i++)
+  {
+    GEN u = gel(Tr, i-1);
+    GEN t = cgetg(lg(gel(Tr,i)), t_VEC);
+    GEN v = gel(Tp, i-1);
+    long n = lg(v)-1;
+    for (j=1, k=1; k<n; j++, k+=2)
+      gel(t, j) = FpXX_add(FpXQX_mul(gel(u, k), gel(v, k+1), T, p),
+                           FpXQX_mul(gel(u, k+1), gel(v, k), T, p), p);
+    gel(Tp, i) = t;
+  }
+  return gerepilecopy(av, FpXQX_renormalize(gmael(Tp,m,1), lg(gmael(Tp,m,1))));
+}
+
+static GEN
+FpXQX_FpXQV_eval(GEN P, GEN xa, GEN T, GEN p)
+{
+  long i, l = lg(xa);
+  GEN R = cgetg(l, t_VEC);
+  for (i=1; i<l; i++) gel(R,i) = FqX_eval(P, gel(xa,i), T, p);
+  return R;
+}
+
+/* evaluate P at all Fq in xa, using a remainder tree for large inputs */
+GEN
+FpXQX_FpXQV_multieval(GEN P, GEN xa, GEN T, GEN p)
+{
+  pari_sp av = avma;
+  GEN s, Tr;
+  if (minss(lgpol(P), lg(xa)-1) < FpXQX_MULTIEVAL_LIMIT)
+    return gerepileupto(av, FpXQX_FpXQV_eval(P, xa, T, p));
+  s = producttree_scheme(lg(xa)-1);
+  Tr = FpXQV_producttree(xa, s, T, p, varn(P));
+  return gerepileupto(av, FpXQX_FpXQV_multieval_tree(P, xa, Tr, T, p));
+}
+
+/* FpXQX P of degree < #xa such that P(xa[i]) = ya[i] */
+GEN
+FpXQV_polint(GEN xa, GEN ya, GEN T, GEN p, long vs)
+{
+  pari_sp av = avma;
+  GEN s, Tr, P, R;
+  long i, l, m;
+  if (lg(xa) == 1) return pol_0(vs);
+  s = producttree_scheme(lg(xa)-1);
+  Tr = FpXQV_producttree(xa, s, T, p, vs);
+  m = lg(Tr)-1;
+  P = FpXX_deriv(gmael(Tr, m, 1), p);
+  R = FpXQX_FpXQV_multieval_tree(P, xa, Tr, T, p); l = lg(R);
+  for (i = 1; i < l; i++) gel(R,i) = Fq_to_FpXQ(gel(R,i), T, p);
+  R = FpXQV_inv(R, T, p);
+  return gerepileupto(av, FpXQVV_polint_tree(Tr, R, s, xa, ya, T, p, vs));
+}
+
 static GEN
 _FpXQX_divrem(void * E, GEN x, GEN y, GEN *r)
 {
@@ -409,6 +409,27 @@ gen_matmul(GEN A, GEN B, void *E, const struct bb_field *ff)
   return C;
 }
 
+/* invert all elements of x using Montgomery's multi-inverse trick:
+ * a single field inversion plus 3(N-1) multiplications. Not stack-clean. */
+GEN
+gen_V_inv(GEN x, void *E, const struct bb_field *ff)
+{
+  long i, lx = lg(x);
+  GEN u, y = cgetg(lx, typ(x));
+
+  if (lx == 1) return y;
+  gel(y,1) = gel(x,1);
+  for (i=2; i<lx; i++) gel(y,i) = ff->red(E, ff->mul(E, gel(y,i-1), gel(x,i)));
+
+  u = ff->inv(E, gel(y,--i));
+  for ( ; i > 1; i--)
+  {
+    gel(y,i) = ff->red(E, ff->mul(E, u, gel(y,i-1)));
+    u = ff->red(E, ff->mul(E, u, gel(x,i))); /* u = 1 / (x[1] ... x[i-1]) */
+  }
+  gel(y,1) = u; return y;
+}
+
 static GEN
 image_from_pivot(GEN x, GEN d, long r)
 {
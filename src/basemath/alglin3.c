@@ -596,7 +596,7 @@ parselect(GEN C, GEN D, long flag)
 {
   pari_sp av, av2;
   long lv, l = lg(D), i, pending = 0, workid;
-  GEN V, worker, done;
+  GEN V, worker, done, E;
   struct pari_mt pt;
   check_callgen1(C, "parselect");
   if (!is_vec_t(typ(D))) pari_err_TYPE("parapply",D);
@@ -604,9 +604,10 @@ parselect(GEN C, GEN D, long flag)
   worker = strtoclosure("_parapply_worker", 1, C);
   av2 = avma;
   mt_queue_start(&pt, worker);
+  E = mt_queue_share(&pt, D);
   for (i=1; i<l || pending; i++)
   {
-    mt_queue_submit(&pt, i, i<l? mkvec(gel(D,i)): NULL);
+    mt_queue_submit(&pt, i, i<l? mkvec(gel(E,i)): NULL);
     done = mt_queue_get(&pt, &workid, &pending);
     if (done) V[workid] = !gequal0(done);
     avma = av2;
@@ -692,6 +693,7 @@ genapply(void *E, GEN (*f)(void* E, GEN x), GEN x)
             list_data(y) = vecapply1(E,f,z);
             break;
           case t_LIST_MAP:
+          case t_LIST_HASHMAP:
             list_data(y) = mapapply1(E,f,z);
             break;
           }
@@ -756,6 +758,7 @@ parapply(GEN C, GEN D)
   worker = strtoclosure("_parapply_worker", 1, C);
   V = cgetg(l, typ(D));
   mt_queue_start(&pt, worker);
+  D = mt_queue_share(&pt, D);
   for (i=1; i<l || pending; i++)
   {
     mt_queue_submit(&pt, i, i<l? mkvec(gel(D,i)): NULL);
@@ -809,7 +812,7 @@ gtomat(GEN x)
   switch(typ(x))
   {
     case t_LIST:
-      if (list_typ(x)==t_LIST_MAP)
+      if (list_typ(x)!=t_LIST_RAW)
         return maptomat(x);
       x = list_data(x);
       if (!x) return cgetg(1, t_MAT);
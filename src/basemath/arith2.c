@@ -1039,7 +1039,7 @@ fromdigitsu_dac(GEN x, GEN vB, long i, long l)
 }
 
 GEN
-fromdigitsu(GEN x, GEN B)
+fromdigitsu_worker(GEN x, GEN B)
 {
   pari_sp av = avma;
   long n = lg(x)-1;
@@ -1050,6 +1050,41 @@ fromdigitsu(GEN x, GEN B)
   return gerepileuptoint(av, z);
 }
 
+/* Parallel fromdigitsu: convert 2^j slices of x in parallel, then glue them
+ * together in base B^s, s = slice length */
+static GEN
+fromdigitsu_mt(GEN x, GEN B)
+{
+  pari_sp av = avma;
+  long i, pending = 0, n = lg(x)-1;
+  long j = expu(pari_mt_nbthreads-1)+1, m = 1L<<j, s = (n+m-1)>>j;
+  struct pari_mt pt;
+  GEN V = cgetg(m+1, t_VEC), worker = strtoclosure("_fromdigitsu_worker", 1, B);
+  mt_queue_start(&pt, worker);
+  for (i = 1; i <= m || pending; i++)
+  {
+    long workid;
+    GEN done, work = NULL;
+    if (i <= m) work = mkvec(vecslice(x, minss((i-1)*s+1, n+1), minss(i*s, n)));
+    mt_queue_submit(&pt, i, work);
+    done = mt_queue_get(&pt, &workid, &pending);
+    if (done) gel(V,workid) = done;
+  }
+  mt_queue_end(&pt);
+  return gerepileuptoint(av, gen_fromdigits(V, powiu(B, s), NULL, &Z_ring));
+}
+
+GEN
+fromdigitsu(GEN x, GEN B)
+{
+  long n = lg(x)-1;
+  /* FROMDIGITS_PARALLEL_LIMIT counts digits; < 0 disables the mt variant */
+  if (FROMDIGITS_PARALLEL_LIMIT >= 0 && n >= FROMDIGITS_PARALLEL_LIMIT
+      && pari_mt_nbthreads > 1 && !mt_is_thread())
+    return fromdigitsu_mt(x, B);
+  return fromdigitsu_worker(x, B);
+}
+
 static int
 ZV_in_range(GEN v, GEN B)
 {
@@ -1821,7 +1821,7 @@ gtoset(GEN x)
     case t_VEC:
     case t_COL: lx = lg(x); break;
     case t_LIST:
-      if (list_typ(x)==t_LIST_MAP) return mapdomain(x);
+      if (list_typ(x)!=t_LIST_RAW) return mapdomain(x);
       x = list_data(x); lx = x? lg(x): 1; break;
     case t_VECSMALL: lx = lg(x); x = zv_to_ZV(x); break;
     default: return mkveccopy(x);
@@ -1113,18 +1113,12 @@ log_m1(long r1, long ru, long prec)
   for (   ; i<=ru; i++) gel(v,i) = a2;
   return v;
 }
+/* log. embeddings of the units from their arch. components A */
 static GEN
-getfu(GEN nf, GEN *ptA, long *pte, long prec)
+getfu_matep(GEN A, long R1, long RU, long N)
 {
-  GEN u, y, matep, A, vec, T = nf_get_pol(nf), M = nf_get_M(nf);
-  long e, i, j, R1, RU, N = degpol(T);
-
-  if (DEBUGLEVEL) err_printf("\n#### Computing fundamental units\n");
-  R1 = nf_get_r1(nf); RU = (N+R1)>>1;
-  if (RU==1) { *pte=LONG_MAX; return cgetg(1,t_VEC); }
-
-  *pte = 0; A = *ptA;
-  matep = cgetg(RU,t_MAT);
+  GEN matep = cgetg(RU,t_MAT);
+  long i, j;
   for (j=1; j<RU; j++)
   {
     GEN c = cgetg(RU+1,t_COL), Aj = gel(A,j);
@@ -1133,20 +1127,45 @@ getfu(GEN nf, GEN *ptA, long *pte, long prec)
     for (i=1; i<=R1; i++) gel(c,i) = gadd(s, gel(Aj,i));
     for (   ; i<=RU; i++) gel(c,i) = gadd(s, gmul2n(gel(Aj,i),-1));
   }
-  u = lll(real_i(matep));
-  if (lg(u) < RU) return not_given(fupb_PRECI);
+  return matep;
+}
 
-  y = RgM_mul(matep,u);
+/* the units (on the integral basis) whose log. embeddings are the columns
+ * of y, NULL if they cannot be recovered at precision prec */
+static GEN
+getfu_solve(GEN nf, GEN y, long *pte, long prec)
+{
+  long e, j, l = lg(y);
   if (!exp_OK(y, pte))
     return not_given(*pte == LONG_MAX? fupb_LARGE: fupb_PRECI);
-  if (prec <= 0) prec = gprecision(A);
-  y = RgM_solve_realimag(M, gexp(y,prec));
+  y = RgM_solve_realimag(nf_get_M(nf), gexp(y,prec));
   if (!y) return not_given(fupb_PRECI);
   y = grndtoi(y, &e);
   *pte = -e;
   if (e >= 0) return not_given(fupb_PRECI);
-  for (j=1; j<RU; j++)
+  for (j=1; j<l; j++)
     if (!is_pm1(nfnorm(nf, gel(y,j)))) { *pte=0; return not_given(fupb_PRECI); }
+  return y;
+}
+
+static GEN
+getfu(GEN nf, GEN *ptA, long *pte, long prec)
+{
+  GEN u, y, matep, A, vec, T = nf_get_pol(nf);
+  long j, R1, RU, N = degpol(T);
+
+  if (DEBUGLEVEL) err_printf("\n#### Computing fundamental units\n");
+  R1 = nf_get_r1(nf); RU = (N+R1)>>1;
+  if (RU==1) { *pte=LONG_MAX; return cgetg(1,t_VEC); }
+
+  *pte = 0; A = *ptA;
+  matep = getfu_matep(A, R1, RU, N);
+  u = lll(real_i(matep));
+  if (lg(u) < RU) return not_given(fupb_PRECI);
+
+  if (prec <= 0) prec = gprecision(A);
+  y = getfu_solve(nf, RgM_mul(matep,u), pte, prec);
+  if (!y) return NULL;
   A = RgM_mul(A,u);
   settyp(y, t_VEC);
   /* y[i] are unit generators. Normalize: smallest T2 norm + lead coeff > 0 */
@@ -1171,6 +1190,19 @@ getfu(GEN nf, GEN *ptA, long *pte, long prec)
   *ptA = A; return y;
 }
 
+/* lazy bnf: the arch. components A of the units are LLL-reduced as in
+ * getfu, but the units themselves are only computed by makeunits, from A
+ * and without normalization, so that they match A */
+static GEN
+getfu_lazy(GEN nf, GEN A)
+{
+  long R1 = nf_get_r1(nf), N = nf_get_degree(nf), RU = (N+R1)>>1;
+  GEN u;
+  if (RU == 1) return A;
+  u = lll(real_i(getfu_matep(A, R1, RU, N)));
+  return lg(u) < RU? A: RgM_mul(A,u);
+}
+
 static GEN
 makeunits(GEN BNF)
 {
@@ -1186,6 +1218,17 @@ makeunits(GEN BNF)
       pari_err_PREC("makeunits [cannot compute units, use bnfinit(,1)]");
     fu = gerepilecopy(av, fu);
   }
+  else if (typ(fu) == t_INT)
+  { /* lazy bnf */
+    pari_sp av = avma;
+    GEN A = bnf_get_logfu(bnf);
+    long R1 = nf_get_r1(nf), N = nf_get_degree(nf), RU = (N+R1)>>1;
+    if (DEBUGLEVEL) pari_warn(warner,"completing bnf (building units)");
+    fu = getfu_solve(nf, getfu_matep(A, R1, RU, N), &l, gprecision(A));
+    if (!fu)
+      pari_err_PREC("makeunits [cannot compute units, use bnfinit(,1)]");
+    fu = gerepilecopy(av, fu);
+  }
   l = lg(fu) + 1; v = cgetg(l, t_VEC);
   gel(v,1) = nf_to_scalar_or_basis(nf,bnf_get_tuU(bnf));
   for (i = 2; i < l; i++) gel(v,i) = algtobasis(nf, gel(fu,i-1));
@@ -3499,6 +3542,16 @@ bnf_build_matalpha(GEN bnf)
 GEN
 bnf_build_units(GEN bnf)
 { return obj_checkbuild(bnf, UNITS, &makeunits); }
+/* fundamental units of a lazy bnf, in algebraic form */
+GEN
+bnf_build_fu(GEN bnf)
+{
+  GEN U = bnf_build_units(bnf), nf = bnf_get_nf(bnf), fu;
+  long i, l = lg(U);
+  fu = cgetg(l-1, t_VEC);
+  for (i = 2; i < l; i++) gel(fu,i-1) = nf_to_scalar_or_alg(nf, gel(U,i));
+  return fu;
+}
 
 static GEN
 get_regulator(GEN mun)
@@ -3726,9 +3779,9 @@ bnfinit0(GEN P, long flag, GEN data, long prec)
   }
   switch(flag)
   {
-    case 2:
     case 0: fl = 0; break;
     case 1: fl = nf_FORCE; break;
+    case 2: fl = nf_LAZY; break;
     default: pari_err_FLAG("bnfinit");
       return NULL; /* not reached */
   }
@@ -3968,8 +4021,8 @@ try_elt(RELCACHE_t *cache, FB_t *F, GEN nf, GEN x, FACT *fact)
   avma = av;
 }
 
-GEN
-Buchall_param(GEN P, double cbach, double cbach2, long nbrelpid, long flun, long prec)
+static GEN
+Buchall_param_i(GEN P, double cbach, double cbach2, long nbrelpid, long flun, long prec, pari_stack *s_old)
 {
   pari_timer T;
   pari_sp av0 = avma, av, av2;
@@ -4149,8 +4202,8 @@ START:
   add_cyclotomic_units(nf, zu, &cache, &F);
   cache.end = cache.last + need;
 
-  W = NULL; zc = 0;
-  sfb_trials = nreldep = 0;
+  gpromote_release(s_old); W = NULL;
+  zc = 0; sfb_trials = nreldep = 0;
 
   if (computed)
   {
@@ -4283,7 +4336,8 @@ START:
         precdouble++; precpb = NULL;
 
         for (i = 1; i < lg(PERM); i++) F.perm[i] = PERM[i];
-        cache.chk = cache.base; W = NULL; /* recompute arch components+reduce */
+        /* recompute arch components+reduce */
+        cache.chk = cache.base; gpromote_release(s_old); W = NULL;
       }
       avma = av4;
       if (cache.chk != cache.last)
@@ -4309,7 +4363,12 @@ START:
         }
         else
           W = hnfadd_i(W, F.perm, &dep, &B, &C, mat, emb);
-        gerepileall(av2, 4, &W,&C,&B,&dep);
+        /* W is large and lives through many iterations: promote it out of
+         * the stack. B, C, dep may share entries with the previous W, which
+         * is the only object in s_old: copy them before releasing it */
+        W = gclone(W);
+        gerepileall(av2, 3, &C,&B,&dep);
+        gpromote_release(s_old); pari_stack_pushp(s_old, (void*)W);
         cache.chk = cache.last;
         if (DEBUGLEVEL)
         {
@@ -4436,8 +4495,16 @@ START:
         if (precadd <= 0) precadd = 1;
         precpb = "cleanarch"; continue;
       }
-      fu = getfu(nf, &A, &e, PRECREG);
-      if (DEBUGLEVEL) timer_printf(&T, "getfu");
+      if (flun & nf_LAZY)
+      { /* computed on demand by makeunits */
+        A = getfu_lazy(nf, A);
+        fu = RU == 1? cgetg(1,t_VEC): gen_0;
+      }
+      else
+      {
+        fu = getfu(nf, &A, &e, PRECREG);
+        if (DEBUGLEVEL) timer_printf(&T, "getfu");
+      }
       if (!fu && (flun & nf_FORCE))
       { /* units not found but we want them */
         if (e > 0) pari_err_OVERFLOW("bnfinit [fundamental units too large]");
@@ -4464,6 +4531,25 @@ START:
   return res;
 }
 
+/* the HNF W is promoted out of the stack by Buchall_param_i: release it on
+ * error as well */
+GEN
+Buchall_param(GEN P, double cbach, double cbach2, long nbrelpid, long flun, long prec)
+{
+  GEN *old, res = NULL;
+  pari_stack s_old;
+  pari_stack_init(&s_old, sizeof(*old), (void**)&old);
+  pari_CATCH(CATCH_ALL) {
+    GEN E = pari_err_last();
+    gpromote_release(&s_old); pari_stack_delete(&s_old);
+    pari_err(0, E);
+  } pari_TRY {
+    res = Buchall_param_i(P, cbach, cbach2, nbrelpid, flun, prec, &s_old);
+  } pari_ENDCATCH;
+  gpromote_release(&s_old); pari_stack_delete(&s_old);
+  return res;
+}
+
 
 GEN
 random_units(GEN P, int flag, int max_time, int max_rel, int n_units, int n_val, long prec)
@@ -4476,8 +4562,8 @@ random_units(GEN P, int flag, int max_time, int max_rel, int n_units, int n_val,
  * 3 conditions 1 and 2
  * */
 
-GEN
-random_units_param(GEN P, int flag, int max_time, int max_rel, int n_units, int n_val, double cbach, double cbach2, long nbrelpid, long flun, long prec)
+static GEN
+random_units_i(GEN P, int flag, int max_time, int max_rel, int n_units, int n_val, double cbach, double cbach2, long nbrelpid, long flun, long prec, pari_stack *s_old)
 {
   pari_timer T;
   pari_sp av0 = avma, av, av2;
@@ -4663,7 +4749,7 @@ START:
   add_cyclotomic_units(nf, zu, &cache, &F);
   cache.end = cache.last + need;
   
-  W = NULL;
+  gpromote_release(s_old); W = NULL;
   sfb_trials = nreldep = 0;
 
   if (computed)
@@ -4801,7 +4887,8 @@ START:
         precdouble++; precpb = NULL;
 
         for (i = 1; i < lg(PERM); i++) F.perm[i] = PERM[i];
-        cache.chk = cache.base; W = NULL; /* recompute arch components+reduce */
+        /* recompute arch components+reduce */
+        cache.chk = cache.base; gpromote_release(s_old); W = NULL;
       }
       avma = av4;
       if (cache.chk != cache.last)
@@ -4838,15 +4925,20 @@ START:
           }
 	}
 	/* storing the values in respective elements */
+        /* the new columns are promoted once and for all, so that
+         * gerepileall_young below only copies the arrays of pointers */
+        elem = gpromote(s_old, vecpermute(elem, remove_induces));
+        mat = gpromote(s_old, vecpermute(mat, remove_induces));
+        matP = gpromote(s_old, vecpermute(matP, remove_induces));
         if (first) {
-          E = vecpermute(elem, remove_induces);
-          W = vecpermute(mat, remove_induces); 
-          WP = vecpermute(matP, remove_induces);
+          E = elem;
+          W = mat;
+          WP = matP;
         }
         else{
-	  E = concat(E, vecpermute(elem, remove_induces));
-	  W = concat(W, vecpermute(mat, remove_induces));
-	  WP = concat(WP, vecpermute(matP, remove_induces));
+	  E = shallowconcat(E, elem);
+	  W = shallowconcat(W, mat);
+	  WP = shallowconcat(WP, matP);
 	}
 	/* compute the elements in kernel of W mod 2 or the elements with square norm */
 	GEN ker_W = FpM_ker(W, gen_2);
@@ -4898,7 +4990,7 @@ START:
 	    }
           }
         fu = fu0;
-        gerepileall(av2, 4, &W, &WP, &E, &fu);
+        gerepileall_young(av2, 4, &W, &WP, &E, &fu);
         cache.chk = cache.last;
       }
       if (unit_num > 0){
@@ -4915,5 +5007,24 @@ START:
   } while ((need || precpb) && done == 0);
   
   delete_cache(&cache); delete_FB(&F); free_GRHcheck(&GRHcheck);
+  return fu? gerepilecopy(av0, fu): NULL;
+}
+
+/* the columns of E, W, WP are promoted out of the stack by random_units_i:
+ * release them on error as well */
+GEN
+random_units_param(GEN P, int flag, int max_time, int max_rel, int n_units, int n_val, double cbach, double cbach2, long nbrelpid, long flun, long prec)
+{
+  GEN *old, fu = NULL;
+  pari_stack s_old;
+  pari_stack_init(&s_old, sizeof(*old), (void**)&old);
+  pari_CATCH(CATCH_ALL) {
+    GEN E = pari_err_last();
+    gpromote_release(&s_old); pari_stack_delete(&s_old);
+    pari_err(0, E);
+  } pari_TRY {
+    fu = random_units_i(P, flag, max_time, max_rel, n_units, n_val, cbach, cbach2, nbrelpid, flun, prec, &s_old);
+  } pari_ENDCATCH;
+  gpromote_release(&s_old); pari_stack_delete(&s_old);
   return fu;
 }
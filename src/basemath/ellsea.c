@@ -47,26 +47,204 @@ static char *
 seadata_filename(ulong ell)
 { return stack_sprintf("%s/seadata/sea%ld", pari_datadir, ell); }
 
+static char *
+seadata_binname(void)
+{ return stack_sprintf("%s/seadata/sea.bin", pari_datadir); }
+
+/* Binary seadata: a keyed binary file (see writebinkey), holding the table
+ * of small levels under the key 0, and the modular equation of level ell
+ * under the key ell. An entry [ell, type, L] is packed as [ell, type, S, D]:
+ * S[i] = -1 if L[i] is a t_INT, the length of the t_VEC L[i] otherwise, and
+ * the t_VECSMALL D = [n, bytes] holds the n bytes encoding the coefficients
+ * in order. A t_INT x is coded as a varint u (7 bits per byte, least
+ * significant first) with bit 1 the sign of x: if bit 0 is 0, |x| = u >> 2,
+ * otherwise u >> 2 bytes follow giving |x|, least significant first. */
+
+static long
+pack_uvarint(unsigned char *s, ulong u)
+{
+  long n = 0;
+  for (; u >= 0x80UL; u >>= 7, n++)
+    if (s) s[n] = (unsigned char)(u | 0x80UL);
+  if (s) s[n] = (unsigned char)u;
+  return n+1;
+}
+
+static ulong
+unpack_uvarint(const unsigned char **ps)
+{
+  const unsigned char *s = *ps;
+  ulong u = 0;
+  long k = 0;
+  do { u |= (ulong)(*s & 0x7f) << k; k += 7; } while (*s++ & 0x80);
+  *ps = s; return u;
+}
+
+/* write the code of x to s (if s != NULL), return its length */
+static long
+pack_int(unsigned char *s, GEN x)
+{
+  ulong neg = signe(x) < 0? 2: 0;
+  long i, n, nb;
+  if (typ(x) != t_INT) pari_err_TYPE("seadatatobin", x);
+  if (lgefint(x) == 2) return pack_uvarint(s, 0);
+  if (lgefint(x) == 3 && uel(x,2) < (1UL << (BITS_IN_LONG-2)))
+    return pack_uvarint(s, (uel(x,2) << 2) | neg);
+  nb = (expi(x) >> 3) + 1;
+  n = pack_uvarint(s, ((ulong)nb << 2) | neg | 1);
+  if (s)
+    for (i = 0; i < nb; i++)
+    {
+      ulong w = *int_W(x, i / sizeof(long));
+      s[n+i] = (unsigned char)(w >> ((i % sizeof(long)) << 3));
+    }
+  return n + nb;
+}
+
 static GEN
-get_seadata(ulong ell)
+unpack_int(const unsigned char **ps)
+{
+  ulong u = unpack_uvarint(ps);
+  long i, nb, nw;
+  GEN x;
+  if (!(u & 1)) return (u & 2)? utoineg(u >> 2): utoi(u >> 2);
+  nb = u >> 2; nw = (nb + sizeof(long) - 1) / sizeof(long);
+  x = cgetipos(nw + 2);
+  for (i = 0; i < nw; i++) *int_W(x, i) = 0;
+  for (i = 0; i < nb; i++)
+    *int_W(x, i / sizeof(long)) |= (ulong)(*ps)[i] << ((i % sizeof(long)) << 3);
+  *ps += nb;
+  if (u & 2) togglesign(x);
+  return x;
+}
+
+/* code the t_INT and the entries of the t_VEC in L to s, return the length */
+static long
+pack_list(unsigned char *s, GEN L)
+{
+  long i, j, n = 0, l = lg(L);
+  for (i = 1; i < l; i++)
+  {
+    GEN c = gel(L,i);
+    if (typ(c) != t_VEC) n += pack_int(s? s+n: NULL, c);
+    else
+      for (j = 1; j < lg(c); j++) n += pack_int(s? s+n: NULL, gel(c,j));
+  }
+  return n;
+}
+
+static GEN
+seadata_pack(GEN C)
+{
+  GEN L = gel(C,3), S, D;
+  long i, l = lg(L), n = pack_list(NULL, L);
+  S = cgetg(l, t_VECSMALL);
+  for (i = 1; i < l; i++)
+    S[i] = typ(gel(L,i)) == t_VEC? lg(gel(L,i))-1: -1;
+  D = zero_zv(1 + (n + sizeof(long) - 1) / sizeof(long));
+  D[1] = n; (void)pack_list((unsigned char*)(D+2), L);
+  return mkvec4(gel(C,1), gel(C,2), S, D);
+}
+
+static GEN
+seadata_unpack(GEN P)
+{
+  GEN S = gel(P,3), D = gel(P,4), L;
+  const unsigned char *s = (const unsigned char*)(D+2);
+  long i, j, l = lg(S);
+  L = cgetg(l, t_VEC);
+  for (i = 1; i < l; i++)
+    if (S[i] < 0) gel(L,i) = unpack_int(&s);
+    else
+    {
+      GEN c = cgetg(S[i]+1, t_VEC);
+      for (j = 1; j <= S[i]; j++) gel(c,j) = unpack_int(&s);
+      gel(L,i) = c;
+    }
+  return mkvec3(gel(P,1), gel(P,2), L);
+}
+
+/* the seadata of level ell from the text files, NULL if not available */
+static GEN
+seadata_text(ulong ell)
 {
-  pari_sp av = avma;
   GEN eqn;
   char *s = seadata_filename(ell);
   pariFILE *F = pari_fopengz(s);
   if (!F) return NULL;
   if (ell) /* large single polynomial */
     eqn = gp_read_stream(F->file);
-  else
-  { /* table of polynomials of small level */
+  else /* table of polynomials of small level */
     eqn = gp_readvec_stream(F->file);
+  pari_fclose(F);
+  return eqn;
+}
+
+/* the seadata of level ell from the binary file, NULL if not available */
+static GEN
+seadata_bin(ulong ell)
+{
+  GEN eqn = readbinkey_i(seadata_binname(), utoi(ell));
+  long i, l;
+  if (!eqn) return NULL;
+  if (ell) return seadata_unpack(eqn);
+  l = lg(eqn);
+  for (i = 1; i < l; i++) gel(eqn,i) = seadata_unpack(gel(eqn,i));
+  return eqn;
+}
+
+static GEN
+get_seadata(ulong ell)
+{
+  pari_sp av = avma;
+  GEN eqn = seadata_bin(ell);
+  if (!eqn) eqn = seadata_text(ell);
+  if (eqn && !ell)
+  {
     modular_eqn = eqn = gclone(eqn);
     avma = av;
   }
-  pari_fclose(F);
   return eqn;
 }
 
+/* levels of the large equations looked for by seadata_tobin */
+#define SEADATA_MAXLEVEL 2000
+
+/* convert the seadata text files to the binary file name (NULL: the one
+ * looked for by ellsea). An existing binary file is replaced */
+void
+seadata_tobin(const char *name)
+{
+  pari_sp av = avma, av2;
+  const char *s = name? name: seadata_binname();
+  GEN T = seadata_text(0);
+  forprime_t S;
+  ulong ell;
+  long i, l;
+  if (!T) pari_err_FILE("seadata file", seadata_filename(0));
+  binfile_unlink(s); /* writebinkey appends */
+  l = lg(T);
+  for (i = 1; i < l; i++) gel(T,i) = seadata_pack(gel(T,i));
+  writebinkey(s, gen_0, T, 0);
+  u_forprime_init(&S, l == 1? 2: itou(gmael(T,l-1,1)) + 1, SEADATA_MAXLEVEL);
+  av2 = avma;
+  while ((ell = u_forprime_next(&S)))
+  {
+    GEN C = seadata_text(ell);
+    if (C) writebinkey(s, utoi(ell), seadata_pack(C), 0);
+    avma = av2;
+  }
+  avma = av;
+}
+
+void
+gpseadata_tobin(const char *s)
+{
+  pari_sp av = avma;
+  char *t = wr_check(s? s: seadata_binname());
+  seadata_tobin(t); pari_free(t); avma = av;
+}
+
 /*Builds the modular equation corresponding to the vector list. Shallow */
 static GEN
 list_to_pol(GEN list, long vx, long vy)
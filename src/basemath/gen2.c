@@ -590,7 +590,7 @@ cmp_universal(GEN x, GEN y)
         if (!vy) return 1;
         switch (tx)
         {
-        case t_LIST_MAP:
+        case t_LIST_MAP: case t_LIST_HASHMAP:
           {
             pari_sp av = avma;
             int ret = cmp_universal_rec(maptomat_shallow(x), maptomat_shallow(y),1);
@@ -911,12 +911,19 @@ closure_identical(GEN x, GEN y)
   return gidentical(gel(x,7),gel(y,7));
 }
 
+/* a hash map is equal (==) to a tree map with the same contents, but they
+ * are not identical (===), so that they remain distinct as map keys */
 static int
 list_cmp(GEN x, GEN y, int cmp(GEN x, GEN y))
 {
-  int t = list_typ(x);
+  int t = list_typ(x), ty = list_typ(y);
   GEN vx, vy;
-  if (list_typ(y)!=t) return 0;
+  if (cmp == gequal)
+  {
+    if (t == t_LIST_HASHMAP) t = t_LIST_MAP;
+    if (ty == t_LIST_HASHMAP) ty = t_LIST_MAP;
+  }
+  if (ty != t) return 0;
   vx = list_data(x);
   vy = list_data(y);
   if (!vx) return vy? 0: 1;
@@ -924,7 +931,7 @@ list_cmp(GEN x, GEN y, int cmp(GEN x, GEN y))
   if (lg(vx) != lg(vy)) return 0;
   switch (t)
   {
-  case t_LIST_MAP:
+  case t_LIST_MAP: case t_LIST_HASHMAP:
     {
       pari_sp av = avma;
       GEN mx  = maptomat_shallow(x), my = maptomat_shallow(y);
@@ -2782,6 +2789,12 @@ mkmap(void)
   return mklist_typ(t_LIST_MAP);
 }
 
+GEN
+mkhashmap(void)
+{
+  return mklist_typ(t_LIST_HASHMAP);
+}
+
 /* return a list with single element x, allocated on stack */
 GEN
 mklistcopy(GEN x)
@@ -387,17 +387,227 @@ treedelete(GEN T, GEN x, long mode)
   return 1;
 }
 
+/* Hash maps (t_LIST_HASHMAP). Node i is [[k,v], gen_0], except that node 1
+ * holds the hash table instead of gen_0: a t_VECSMALL, cloned separately,
+ * tab[1] = m (number of buckets, a power of 2, n <= m), then the hashes of
+ * the keys of the n nodes, their successors in their bucket and the m bucket
+ * heads. Keeping all this in a single block avoids scattered memory
+ * accesses. */
+#define htab()    gmael(list_data(T),1,2)
+#define hsize(t)  ((t)[1])
+#define hhash(t,i) ((t)[1+(i)])
+#define hnext(t,i) ((t)[1+hsize(t)+(i)])
+#define hhead(t,b) ((t)[2+2*hsize(t)+(b)])
+
+static ulong
+map_hash(GEN x) { return hash_GEN(x); }
+
+static void
+hashlink(GEN t, long i, ulong h)
+{
+  long b = h & (hsize(t)-1);
+  hhash(t,i) = (long)h; hnext(t,i) = hhead(t,b); hhead(t,b) = i;
+}
+
+/* new table with m buckets, for the first n nodes of table t */
+static GEN
+hashtab_new(GEN t, long n, long m)
+{
+  GEN u = zero_zv(3*m+1);
+  long i;
+  hsize(u) = m;
+  for (i = 1; i <= n; i++) hashlink(u, i, (ulong)hhash(t,i));
+  return u;
+}
+
+/* attach table t to T, cloning it if T is a GP map */
+static void
+hashtab_set(GEN T, GEN t)
+{
+  GEN o = htab();
+  if (list_nmax(T))
+  {
+    pari_sp av = avma;
+    htab() = gclone(t); avma = av;
+    if (isclone(o)) gunclone(o);
+  }
+  else htab() = t;
+}
+
+/* make sure the table does not live inside the block of node 1 (as in a
+ * copy of a GP map), so that it can be moved to another node */
+static GEN
+hashtab_own(GEN T)
+{
+  GEN t = htab();
+  if (list_nmax(T) && !isclone(t)) htab() = t = gclone(t);
+  return t;
+}
+
+static long
+hashsearch(GEN T, GEN x, ulong h)
+{
+  GEN d = list_data(T), t;
+  long i;
+  if (!d || lg(d)==1) return 0;
+  t = htab();
+  for (i = hhead(t, h & (hsize(t)-1)); i; i = hnext(t,i))
+    if ((ulong)hhash(t,i) == h && gidentical(x, gel(value(i),1))) return i;
+  return 0;
+}
+
+/* replace the value of node i by x, keeping the table in place */
+static void
+hashchange(GEN T, GEN x, long i)
+{
+  pari_sp av = avma;
+  GEN t = i == 1? hashtab_own(T): gen_0;
+  gmael(list_data(T),i,2) = gen_0;
+  listput(T, mkvec2(x, gen_0), i);
+  gmael(list_data(T),i,2) = t;
+  avma = av;
+}
+
+static void
+hashinsert(GEN T, GEN x)
+{
+  ulong h = map_hash(gel(x,1));
+  long i = hashsearch(T, gel(x,1), h), n;
+  pari_sp av;
+  GEN t;
+  if (i) { hashchange(T, x, i); return; }
+  av = avma;
+  listput(T, mkvec2(x, gen_0), 0);
+  n = lg(list_data(T))-1;
+  if (n == 1) t = hashtab_new(NULL, 0, 1);
+  else
+  {
+    t = htab();
+    if (n <= hsize(t)) { hashlink(t, n, h); avma = av; return; }
+    t = hashtab_new(t, n-1, hsize(t) << 1);
+  }
+  hashlink(t, n, h);
+  hashtab_set(T, t); avma = av;
+}
+
+static long
+hashdelete(GEN T, GEN x)
+{
+  GEN d = list_data(T), t;
+  ulong h = map_hash(x);
+  long i, p, l, m, b;
+  if (!d || lg(d)==1) return 0;
+  t = htab(); m = hsize(t); b = h & (m-1);
+  for (p = 0, i = hhead(t,b); i; p = i, i = hnext(t,i))
+    if ((ulong)hhash(t,i) == h && gidentical(x, gel(value(i),1))) break;
+  if (!i) return 0;
+  if (p) hnext(t,p) = hnext(t,i); else hhead(t,b) = hnext(t,i);
+  /* move the last node to position i, then drop it */
+  l = lg(d)-1;
+  if (i != l)
+  {
+    long j;
+    b = hhash(t,l) & (m-1);
+    if (hhead(t,b) == l) hhead(t,b) = i;
+    else
+    {
+      for (j = hhead(t,b); hnext(t,j) != l; j = hnext(t,j)) /* empty */;
+      hnext(t,j) = i;
+    }
+    hhash(t,i) = hhash(t,l); hnext(t,i) = hnext(t,l);
+    if (i == 1) t = hashtab_own(T);
+    swap(gel(d,i), gel(d,l));
+    if (i == 1) swap(gmael(d,1,2), gmael(d,l,2));
+  }
+  listpop(T, 0);
+  if (--l && m > 4*l && list_nmax(T))
+  {
+    pari_sp av = avma;
+    hashtab_set(T, hashtab_new(t, l, m >> 1)); avma = av;
+  }
+  return 1;
+}
+
+/* permutation sorting the keys of the hash map T */
+static GEN
+hashperm(GEN T)
+{
+  GEN d = list_data(T), K;
+  long i, l = d? lg(d): 1;
+  K = cgetg(l, t_VEC);
+  for (i = 1; i < l; i++) gel(K,i) = gel(value(i),1);
+  return gen_indexsort(K, (void*)&cmp_universal, cmp_nodata);
+}
+
+static GEN
+hashkeys(GEN T, long copy)
+{
+  pari_sp av = avma;
+  GEN p = hashperm(T), V;
+  long i, l = lg(p);
+  V = cgetg(l, t_VEC);
+  for (i = 1; i < l; i++)
+  {
+    GEN k = gel(value(p[i]), 1);
+    gel(V,i) = copy? gcopy(k): k;
+  }
+  return gerepileupto(av, V);
+}
+
+static GEN
+hashmat(GEN T, long copy)
+{
+  GEN p = hashperm(T), V, K, W;
+  long i, l = lg(p);
+  if (l == 1) return cgetg(1, t_MAT);
+  V = cgetg(3, t_MAT);
+  gel(V,1) = K = cgetg(l, t_COL);
+  gel(V,2) = W = cgetg(l, t_COL);
+  for (i = 1; i < l; i++)
+  {
+    GEN x = value(p[i]);
+    gel(K,i) = copy? gcopy(gel(x,1)): gel(x,1);
+    gel(W,i) = copy? gcopy(gel(x,2)): gel(x,2);
+  }
+  return V;
+}
+
+/* return 1 if T is a hash map, 0 if it is a tree map */
+static int
+checkmap(GEN T, const char *s)
+{
+  if (typ(T) == t_LIST)
+    switch(list_typ(T))
+    {
+      case t_LIST_MAP: return 0;
+      case t_LIST_HASHMAP: return 1;
+    }
+  pari_err_TYPE(s, T);
+  return 0; /* LCOV_EXCL_LINE */
+}
+
+static GEN
+mapsearch(GEN T, GEN a, const char *s)
+{
+  long i;
+  if (!checkmap(T, s)) return treesearch(T, a, 1);
+  i = hashsearch(T, a, map_hash(a));
+  return i? value(i): NULL;
+}
+
 void
 mapput(GEN T, GEN a, GEN b)
 {
   pari_sp av = avma;
   long i;
-  GEN p;
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("mapput",T);
-  p = mkvec2(a, b);
-  i = treeinsert(T, p, 1);
-  if (i) change_leaf(T, p, i);
+  GEN p = mkvec2(a, b);
+  if (checkmap(T, "mapput"))
+    hashinsert(T, p);
+  else
+  {
+    i = treeinsert(T, p, 1);
+    if (i) change_leaf(T, p, i);
+  }
   avma = av;
 }
 
@@ -405,10 +615,7 @@ void
 mapdelete(GEN T, GEN a)
 {
   pari_sp av = avma;
-  long s;
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("mapdelete",T);
-  s = treedelete(T, a, 1);
+  long s = checkmap(T, "mapdelete")? hashdelete(T, a): treedelete(T, a, 1);
   if (!s) pari_err_COMPONENT("mapdelete", "not in", strtoGENstr("map"), a);
   avma = av;
 }
@@ -416,10 +623,7 @@ mapdelete(GEN T, GEN a)
 GEN
 mapget(GEN T, GEN a)
 {
-  GEN x;
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("mapget",T);
-  x = treesearch(T, a, 1);
+  GEN x = mapsearch(T, a, "mapget");
   if (!x) pari_err_COMPONENT("mapget", "not in", strtoGENstr("map"), a);
   return gcopy(gel(x, 2));
 }
@@ -427,10 +631,7 @@ mapget(GEN T, GEN a)
 int
 mapisdefined(GEN T, GEN a, GEN *pt_z)
 {
-  GEN x;
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("mapisdefined",T);
-  x = treesearch(T, a, 1);
+  GEN x = mapsearch(T, a, "mapisdefined");
   if (!x) return 0;
   if (pt_z) *pt_z = gcopy(gel(x, 2));
   return 1;
@@ -439,32 +640,32 @@ mapisdefined(GEN T, GEN a, GEN *pt_z)
 GEN
 mapdomain(GEN T)
 {
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("mapdomain",T);
+  if (checkmap(T, "mapdomain")) return hashkeys(T,1);
   return treekeys(T,1);
 }
 
 GEN
 mapdomain_shallow(GEN T)
 {
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("mapdomain_shallow",T);
+  if (checkmap(T, "mapdomain_shallow")) return hashkeys(T,0);
   return treekeys_i(T,1);
 }
 
 GEN
 maptomat(GEN T)
 {
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("maptomat",T);
+  if (checkmap(T, "maptomat"))
+  {
+    pari_sp av = avma;
+    return gerepileupto(av, hashmat(T,1));
+  }
   return treemat(T);
 }
 
 GEN
 maptomat_shallow(GEN T)
 {
-  if (typ(T)!=t_LIST || list_typ(T)!=t_LIST_MAP)
-    pari_err_TYPE("maptomap_shallow",T);
+  if (checkmap(T, "maptomat_shallow")) return hashmat(T,0);
   return treemat_i(T);
 }
 
@@ -495,3 +696,47 @@ gtomap(GEN x)
   }
   return NULL; /* NOT REACHED */
 }
+
+static GEN
+gtohashmap(GEN x)
+{
+  long i, n, m, l;
+  GEN M, d, t;
+  if (!x) return mkhashmap();
+  if (typ(x) != t_MAT) pari_err_TYPE("Map",x);
+  l = lg(x);
+  if (l == 1 || lgcols(x)==1) return mkhashmap();
+  if (l != 3) pari_err_TYPE("Map",x);
+  n = lgcols(x)-1;
+  M = cgetg(3, t_LIST);
+  M[1] = evaltyp(t_LIST_HASHMAP)|evallg(n);
+  list_data(M) = d = cgetg(n+1, t_VEC);
+  for (m = 1; m < n; m <<= 1) /* empty */;
+  t = zero_zv(3*m+1); hsize(t) = m;
+  for (i = 1; i <= n; i++)
+  {
+    GEN a = gcoeff(x,i,1);
+    gel(d,i) = mkvec2(mkvec2(gcopy(a), gcopy(gcoeff(x,i,2))), gen_0);
+    hashlink(t, i, map_hash(a));
+  }
+  gmael(d,1,2) = t;
+  for (i = 1; i <= n; i++)
+  {
+    GEN a = gcoeff(x,i,1);
+    if (hashsearch(M, a, map_hash(a)) != i)
+      pari_err_DOMAIN("Map","x","is not",strtoGENstr("one-to-one"),x);
+  }
+  return M;
+}
+
+GEN
+gtomap0(GEN x, long flag)
+{
+  switch(flag)
+  {
+    case 0: return gtomap(x);
+    case 1: return gtohashmap(x);
+  }
+  pari_err_FLAG("Map");
+  return NULL; /* LCOV_EXCL_LINE */
+}
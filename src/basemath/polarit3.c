@@ -1218,22 +1218,21 @@ ZX_ZXY_ResBound(GEN A, GEN B, GEN dB)
   avma = av; return (i <= 0)? 1: 1 + (ulong)i;
 }
 
-/* return Res(a(Y), b(n,Y)) over Fp. la = leading_coeff(a) [for efficiency] */
+/* return Res(a(Y), ev(Y)) over Fp, where ev = b(n,Y) has lost drop leading
+ * terms. la = leading_coeff(a) [for efficiency] */
 static ulong
-Flx_FlxY_eval_resultant(GEN a, GEN b, ulong n, ulong p, ulong la)
+Flx_FlxY_eval_resultant(GEN a, GEN ev, long drop, ulong p, ulong la)
 {
-  GEN ev = FlxY_evalx(b, n, p);
-  long drop = lg(b) - lg(ev);
   ulong r = Flx_resultant(a, ev, p);
   if (drop && la != 1) r = Fl_mul(r, Fl_powu(la, drop,p),p);
   return r;
 }
 static GEN
-FpX_FpXY_eval_resultant(GEN a, GEN b, GEN n, GEN p, GEN la, long db, long vX)
+FpX_FpXY_eval_resultant(GEN a, GEN ev, long db, GEN p, GEN la)
 {
-  GEN ev = FpXY_evaly(b, n, p, vX);
   long drop = db-degpol(ev);
   GEN r = FpX_resultant(a, ev, p);
+  if (!r) return gen_0;
   if (drop && !gequal1(la)) r = Fp_mul(r, Fp_powu(la, drop,p),p);
   return r;
 }
@@ -1243,21 +1242,21 @@ FpX_FpXY_eval_resultant(GEN a, GEN b, GEN n, GEN p, GEN la, long db, long vX)
 static GEN
 Flx_FlxY_resultant_polint(GEN a, GEN b, ulong p, ulong dres, long sx)
 {
+  pari_sp av;
   ulong i, n, la = Flx_lead(a);
   GEN  x = cgetg(dres+2, t_VECSMALL);
-  GEN  y = cgetg(dres+2, t_VECSMALL);
+  GEN  y = cgetg(dres+2, t_VECSMALL), ev;
  /* Evaluate at dres+ 1 points: 0 (if dres even) and +/- n, so that P_n(X) =
   * P_{-n}(-X), where P_i is Lagrange polynomial: P_i(j) = delta_{i,j} */
-  for (i=0,n = 1; i < dres; n++)
-  {
-    x[++i] = n;   y[i] = Flx_FlxY_eval_resultant(a,b, x[i], p,la);
-    x[++i] = p-n; y[i] = Flx_FlxY_eval_resultant(a,b, x[i], p,la);
-  }
-  if (i == dres)
+  for (i=0,n = 1; i < dres; n++) { x[++i] = n; x[++i] = p-n; }
+  if (i == dres) x[++i] = 0;
+  av = avma; ev = FlxY_Flv_evalx(b, x, p);
+  for (i=1; i<=dres+1; i++)
   {
-    x[++i] = 0;   y[i] = Flx_FlxY_eval_resultant(a,b, x[i], p,la);
+    GEN e = gel(ev,i);
+    y[i] = Flx_FlxY_eval_resultant(a, e, lg(b)-lg(e), p, la);
   }
-  return Flv_polint(x,y, p, sx);
+  avma = av; return Flv_polint(x,y, p, sx);
 }
 
 static GEN
@@ -1401,7 +1400,7 @@ GEN
 FpX_FpXY_resultant(GEN a, GEN b, GEN p)
 {
   long i,n,dres, db, vY = varn(b), vX = varn(a);
-  GEN la,x,y;
+  GEN la,x,y,V,ev;
 
   if (lgefint(p) == 3)
   {
@@ -1421,14 +1420,18 @@ FpX_FpXY_resultant(GEN a, GEN b, GEN p)
   for (i=0,n = 1; i < dres; n++)
   {
     gel(x,++i) = utoipos(n);
-    gel(y,i) = FpX_FpXY_eval_resultant(a,b,gel(x,i),p,la,db,vY);
     gel(x,++i) = subis(p,n);
-    gel(y,i) = FpX_FpXY_eval_resultant(a,b,gel(x,i),p,la,db,vY);
   }
-  if (i == dres)
+  if (i == dres) gel(x,++i) = gen_0;
+  /* the coefficients of b in X, as polynomials in Y, at all points at once */
+  V = RgXY_swap(b, db, vY);
+  V = FpXV_FpV_multieval(FpXV_red(RgX_to_RgC(V, db+1), p), x, p);
+  for (i=1; i<=dres+1; i++)
   {
-    gel(x,++i) = gen_0;
-    gel(y,i) = FpX_FpXY_eval_resultant(a,b, gel(x,i), p,la,db,vY);
+    ev = cgetg(db+3, t_POL); ev[1] = evalvarn(vX);
+    for (n=0; n<=db; n++) gel(ev,n+2) = gmael(V,n+1,i);
+    ev = FpX_renormalize(ev, db+3);
+    gel(y,i) = FpX_FpXY_eval_resultant(a, ev, db, p, la);
   }
   return FpV_polint(x,y, p, vY);
 }
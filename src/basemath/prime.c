@@ -443,8 +443,10 @@ u_2_prp(ulong n)
 static int
 uBPSW_psp(ulong n) { return (u_2_prp(n) && uislucaspsp(n)); }
 
-int
-uisprime(ulong n)
+/* Trial division by primes <= 101. Return 1 if n is prime, 0 if n is
+ * composite and -1 if undecided: then n > 10427 has no prime divisor <= 101 */
+static int
+uisprime_trial(ulong n)
 {
   if (n < 103)
     switch(n)
@@ -493,9 +495,14 @@ uisprime(ulong n)
       !uu_coprime(n, 1673450759UL) ||
       !uu_coprime(n, 4269855901UL)) return 0;
 #endif
-  if (n < 10427) return 1;
-  if (n < 1016801) return !is_2_prp_101(n) && u_2_prp(n);
-  return uBPSW_psp(n);
+  return (n < 10427)? 1: -1;
+}
+
+int
+uisprime(ulong n)
+{
+  int r = uisprime_trial(n);
+  return (r < 0)? uisprime_101(n): r;
 }
 
 /* assume no prime divisor <= 101 */
@@ -511,6 +518,139 @@ uisprime_101(ulong n)
 int
 uisprime_661(ulong n) { return uBPSW_psp(n); }
 
+/* Batch testing. The base 2 strong pseudoprime tests of MR_BATCH candidates
+ * are run in lockstep: the modular squarings of distinct candidates are
+ * independent, so that their latencies overlap. */
+#define MR_BATCH 4
+
+/* n[0..k-1] odd > 1, k <= MR_BATCH. Set r[i] = 1 if n[i] is a strong
+ * 2-pseudoprime and 0 otherwise */
+static void
+u_2_prp_batch(const ulong *n, long k, long *r)
+{
+  ulong c[MR_BATCH], t1[MR_BATCH], pi[MR_BATCH];
+  long r1[MR_BATCH], i, j, e = 0;
+
+  for (i = 0; i < k; i++)
+  {
+    r1[i] = vals(n[i] - 1);
+    t1[i] = (n[i] - 1) >> r1[i];
+    pi[i] = get_Fl_red(n[i]);
+    c[i] = 1; e = maxss(e, expu(t1[i]));
+  }
+  /* c[i] = 2^t1[i] mod n[i], left-to-right; leading zero bits square 1 */
+  for (j = e; j >= 0; j--)
+    for (i = 0; i < k; i++)
+    {
+      ulong x = Fl_sqr_pre(c[i], n[i], pi[i]);
+      c[i] = ((t1[i] >> j) & 1)? Fl_double(x, n[i]): x;
+    }
+  for (i = 0; i < k; i++)
+  {
+    ulong x = c[i], t = n[i] - 1;
+    long s = r1[i] - 1;
+    if (x == 1 || x == t) { r[i] = 1; continue; }
+    /* go fishing for -1 */
+    for (r[i] = 0; s && x != 1; s--)
+    {
+      x = Fl_sqr_pre(x, n[i], pi[i]);
+      if (x == t) { r[i] = 1; break; }
+    }
+  }
+}
+
+/* m[0..l-1] have no prime divisor <= 101, l <= MR_BATCH;
+ * set r[J[i]] = uisprime(m[i]) */
+static void
+uisprime_batch_end(const ulong *m, const long *J, long l, long *r)
+{
+  long i, s[MR_BATCH];
+  u_2_prp_batch(m, l, s);
+  for (i = 0; i < l; i++)
+    r[J[i]] = s[i] && (m[i] < 1016801? !is_2_prp_101(m[i]): uislucaspsp(m[i]));
+}
+
+/* r[i] = uisprime(n[i]), 0 <= i < k */
+void
+uisprime_batch(const ulong *n, long k, long *r)
+{
+  ulong m[MR_BATCH];
+  long i, J[MR_BATCH], l = 0;
+  for (i = 0; i < k; i++)
+  {
+    r[i] = uisprime_trial(n[i]);
+    if (r[i] >= 0) continue;
+    m[l] = n[i]; J[l++] = i;
+    if (l == MR_BATCH) { uisprime_batch_end(m, J, l, r); l = 0; }
+  }
+  if (l) uisprime_batch_end(m, J, l, r);
+}
+
+/* v a t_VECSMALL of ulongs; return the t_VECSMALL of uisprime(v[i]) */
+GEN
+zv_isprime(GEN v)
+{
+  long l = lg(v);
+  GEN w = cgetg(l, t_VECSMALL);
+  uisprime_batch((const ulong*)(v + 1), l - 1, w + 1);
+  return w;
+}
+
+/* Store in P the primes in ]a, c], where c <= b is the returned value,
+ * in increasing order and followed by a 0. The odd integers > a are scanned
+ * until MR_BATCH of them need a pseudoprime test, or 8 primes are found:
+ * P must have room for 9 ulongs. Trial division by primes <= 101 is replaced
+ * by sieving a window of 2*MR_SIEVE consecutive integers. */
+#define MR_SIEVE 64
+ulong
+uprimes_batch(ulong a, ulong b, ulong *P)
+{
+  static const ulong pr[] = { 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+    43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101 };
+  unsigned char S[MR_SIEVE];
+  ulong m[MR_BATCH], n, n0 = (a + 1) | 1;
+  long r[9], J[MR_BATCH], i, j, k = 0, l = 0;
+
+  if (n0 > 101 && n0 < n0 + 2*MR_SIEVE)
+  { /* sieve [n0, n0 + 2*MR_SIEVE[ */
+    memset(S, 0, MR_SIEVE);
+    for (j = 0; j < (long)numberof(pr); j++)
+    { /* n0 + 2i = 0 mod p <=> i = (p - n0 mod p) (p+1)/2 mod p */
+      ulong p = pr[j], t = n0 % p;
+      for (i = t? Fl_mul(p - t, (p + 1) >> 1, p): 0; i < MR_SIEVE; i += p)
+        S[i] = 1;
+    }
+    for (i = 0; i < MR_SIEVE; i++)
+    {
+      n = n0 + 2*i;
+      if (n > b) { n = b; break; }
+      if (S[i]) continue;
+      r[k] = (n < 10427)? 1: -1;
+      if (r[k] < 0) { m[l] = n; J[l++] = k; }
+      P[k++] = n;
+      if (l == MR_BATCH || k == 8) break;
+    }
+    if (i == MR_SIEVE) n = n0 + 2*(MR_SIEVE - 1);
+  }
+  else
+  {
+    if (a < 2 && b >= 2) { r[k] = 1; P[k++] = 2; }
+    for (n = n0;; n += 2)
+    {
+      if (n > b || n < a) { n = b; break; } /* done or overflow */
+      r[k] = uisprime_trial(n);
+      if (r[k] == 0) continue;
+      if (r[k] < 0) { m[l] = n; J[l++] = k; }
+      P[k++] = n;
+      if (l == MR_BATCH || k == 8) break;
+    }
+  }
+  if (l) uisprime_batch_end(m, J, l, r);
+  for (i = j = 0; i < k; i++)
+    if (r[i]) P[j++] = P[i];
+  P[j] = 0; return n;
+}
+
 long
 BPSW_psp(GEN N)
 {
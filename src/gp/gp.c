@@ -146,7 +146,7 @@ init_trivial_stack(void)
 {
   const size_t s = 2048;
   pari_mainstack->size = s;
-  pari_mainstack->bot = (pari_sp)pari_malloc(s);
+  pari_mainstack->lim = pari_mainstack->bot = (pari_sp)pari_malloc(s);
   avma = pari_mainstack->top = pari_mainstack->bot + s;
 }
 
@@ -338,6 +338,7 @@ gp_main_loop(long ismain)
   if ((er = setjmp(env[s_env.n-1])))
   { /* recover: jump from error [ > 0 ] or allocatemem [ -1 ] */
     if (er > 0) { /* true error */
+      if (ismain) gp_stack_hwm_record(er);
       if (!(GP_DATA->recover)) exit(1);
       gp_context_restore(&rec);
       /* true error not from main instance, let caller sort it out */
@@ -365,6 +366,7 @@ gp_main_loop(long ismain)
     {
       reset_ctrlc();
       timer_start(GP_DATA->T);
+      gp_stack_hwm_record(0); paristack_hwm_reset();
       pari_set_last_newline(1);
     }
     if (gp_meta(b->buf,ismain)) continue;
@@ -642,6 +644,7 @@ void
 gp_quit(long code)
 {
   free_graph();
+  gp_stack_hwm_record(0); gp_stackfile_write();
   pari_close();
   kill_buffers_upto(NULL);
   if (!(GP_DATA->flags & gpd_QUIET)) pari_puts("Goodbye!\n");
@@ -323,6 +323,7 @@ GEN     FlxM_Flx_add_shallow(GEN x, GEN y, ulong p);
 GEN     FlxM_to_ZXM(GEN z);
 GEN     FlxT_red(GEN z, ulong p);
 GEN     FlxV_Flc_mul(GEN V, GEN W, ulong p);
+GEN     FlxV_Flv_multieval(GEN P, GEN xa, ulong p);
 GEN     FlxV_prod(GEN V, ulong p);
 GEN     FlxV_red(GEN z, ulong p);
 GEN     FlxV_to_Flm(GEN v, long n);
@@ -352,6 +353,7 @@ GEN     FlxY_FlxqV_evalx(GEN P, GEN x, GEN T, ulong p);
 long    FlxY_degreex(GEN b);
 ulong   FlxY_eval_powers_pre(GEN pol, GEN ypowers, GEN xpowers, ulong p, ulong pi);
 GEN     FlxY_evalx(GEN Q, ulong x, ulong p);
+GEN     FlxY_Flv_evalx(GEN Q, GEN x, ulong p);
 GEN     FlxY_evalx_powers_pre(GEN pol, GEN ypowers, ulong p, ulong pi);
 GEN     FlxYqq_pow(GEN x, GEN n, GEN S, GEN T, ulong p);
 GEN     Flxq_autpow(GEN x, ulong n, GEN T, ulong p);
@@ -598,10 +600,13 @@ GEN     FpXQ_sqr(GEN y, GEN T, GEN p);
 GEN     FpXQ_sqrt(GEN a, GEN T, GEN p);
 GEN     FpXQ_sqrtn(GEN a, GEN n, GEN T, GEN p, GEN *zetan);
 GEN     FpXQ_trace(GEN x, GEN T, GEN p);
+GEN     FpXQV_inv(GEN x, GEN T, GEN p);
+GEN     FpXQV_polint(GEN xa, GEN ya, GEN T, GEN p, long v);
 GEN     FpXQC_to_mod(GEN z, GEN T, GEN p);
 GEN     FpXQM_autsum(GEN x, ulong n, GEN T, GEN p);
 GEN     FpXT_red(GEN z, GEN p);
 GEN     FpXV_prod(GEN V, GEN p);
+GEN     FpXV_FpV_multieval(GEN P, GEN xa, GEN p);
 GEN     FpXV_red(GEN z, GEN p);
 int     Fq_issquare(GEN x, GEN T, GEN p);
 long    Fq_ispower(GEN x, GEN K, GEN T, GEN p);
@@ -690,6 +695,7 @@ GEN     polrootsff(GEN f, GEN p, GEN T);
 /* FpXX.c */
 
 GEN     FpXQX_FpXQ_mul(GEN P, GEN U, GEN T, GEN p);
+GEN     FpXQX_FpXQV_multieval(GEN P, GEN xa, GEN T, GEN p);
 GEN     FpXQX_FpXQXQV_eval(GEN P, GEN V, GEN S, GEN T, GEN p);
 GEN     FpXQX_FpXQXQ_eval(GEN P, GEN x, GEN S, GEN T, GEN p);
 GEN     FpXQX_div_by_X_x(GEN a, GEN x, GEN T, GEN p, GEN *pr);
@@ -1434,6 +1440,7 @@ GEN     gen_det(GEN a, void *E, const struct bb_field *ff);
 GEN     gen_ker(GEN x, long deplin, void *E, const struct bb_field *ff);
 GEN     gen_matcolmul(GEN a, GEN b, void *E, const struct bb_field *ff);
 GEN     gen_matmul(GEN a, GEN b, void *E, const struct bb_field *ff);
+GEN     gen_V_inv(GEN x, void *E, const struct bb_field *ff);
 GEN     image(GEN x);
 GEN     image2(GEN x);
 GEN     imagecompl(GEN x);
@@ -2226,6 +2233,7 @@ GEN     gen_sort(GEN x, void *E, int (*cmp)(void*,GEN,GEN));
 void    gen_sort_inplace(GEN x, void *E, int (*cmp)(void*,GEN,GEN), GEN *perm);
 GEN     gen_sort_uniq(GEN x, void *E, int (*cmp)(void*,GEN,GEN));
 long    getstack(void);
+long    getstack0(long flag);
 long    gettime(void);
 long    getabstime(void);
 GEN     getwalltime(void);
@@ -2316,6 +2324,7 @@ GEN     quadray(GEN bnf, GEN f, long prec);
 GEN     Buchall(GEN P, long flag, long prec);
 GEN     Buchall_param(GEN P, double bach, double bach2, long nbrelpid, long flun, long prec);
 GEN     bnf_build_cycgen(GEN bnf);
+GEN     bnf_build_fu(GEN bnf);
 GEN     bnf_build_matalpha(GEN bnf);
 GEN     bnf_build_units(GEN bnf);
 GEN     bnfcompress(GEN bnf);
@@ -2477,6 +2486,7 @@ GEN sd_parisizemax(const char *v, long flag);
 GEN sd_path(const char *v, long flag);
 GEN sd_prettyprinter(const char *v, long flag);
 GEN sd_primelimit(const char *v, long flag);
+GEN sd_primetablefile(const char *v, long flag);
 GEN sd_realbitprecision(const char *v, long flag);
 GEN sd_realprecision(const char *v, long flag);
 GEN sd_secure(const char *v, long flag);
@@ -2507,6 +2517,7 @@ GEN sd_prompt_cont(const char *v, long flag);
 GEN sd_psfile(const char *v, long flag);
 GEN sd_readline(const char *v, long flag);
 GEN sd_recover(const char *v, long flag);
+GEN sd_stackfile(const char *v, long flag);
 GEN sd_timer(const char *v, long flag);
 void pari_hit_return(void);
 void gp_load_gprc(void);
@@ -2520,6 +2531,8 @@ void pari_alarm(long s);
 GEN  gp_alarm(long s, GEN code);
 GEN  gp_input(void);
 void gp_allocatemem(GEN z);
+void gp_stack_hwm_record(long numerr);
+void gp_stackfile_write(void);
 int  gp_handle_exception(long numerr);
 void gp_alarm_handler(int sig);
 void gp_sigint_fun(void);
@@ -2688,13 +2701,19 @@ GEN     ellisomat(GEN E, long flag);
 GEN     Fp_ellcard_SEA(GEN a4, GEN a6, GEN p, ulong smallfact);
 GEN     Fq_ellcard_SEA(GEN a4, GEN a6, GEN q, GEN T, GEN p, ulong smallfact);
 GEN     ellmodulareqn(long l, long vx, long vy);
+void    seadata_tobin(const char *name);
 
 /* es.c */
 
 GEN     externstr(const char *cmd);
+void    forfile(void *E, long call(void*, GEN), const char *name, long flag);
+void    forfile0(GEN name, GEN code, long flag);
 char    *gp_filter(const char *s);
 GEN     gpextern(const char *cmd);
 void    gpsystem(const char *s);
+GEN     readbinkey(const char *name, GEN k);
+GEN     readbinkey_i(const char *name, GEN k);
+GEN     readbinkeys(const char *name);
 GEN     readstr(const char *s);
 GEN     GENtoGENstr_nospace(GEN x);
 GEN     GENtoGENstr(GEN x);
@@ -2792,6 +2811,8 @@ void    warning0(GEN g);
 void    write0(const char *s, GEN g);
 void    write1(const char *s, GEN g);
 void    writebin(const char *name, GEN x);
+void    writebin0(const char *name, GEN x, long flag);
+void    writebinkey(const char *name, GEN K, GEN X, long flag);
 void    writetex(const char *s, GEN g);
 
 /* eval.c */
@@ -2854,6 +2875,7 @@ GEN     forprime_next(forprime_t *T);
 int     forprime_init(forprime_t *T, GEN a, GEN b);
 byteptr initprimes(ulong maxnum, long *lenp, ulong *lastp);
 void    initprimetable(ulong maxnum);
+void    initprimetable_file(ulong maxnum, const char *s);
 ulong   init_primepointer_geq(ulong a, byteptr *pd);
 ulong   init_primepointer_gt(ulong a, byteptr *pd);
 ulong   init_primepointer_leq(ulong a, byteptr *pd);
@@ -2861,6 +2883,8 @@ ulong   init_primepointer_lt(ulong a, byteptr *pd);
 ulong   maxprime(void);
 void    maxprime_check(ulong c);
 void    pari_init_primes(ulong maxprime);
+ulong   primetable_read(const char *s);
+void    primetable_write(const char *s);
 ulong   u_forprime_next(forprime_t *T);
 int     u_forprime_init(forprime_t *T, ulong a, ulong b);
 void    u_forprime_restrict(forprime_t *T, ulong c);
@@ -3065,6 +3089,7 @@ GEN     matsize(GEN x);
 GEN     mklist(void);
 GEN     mklist_typ(long t);
 GEN     mklistcopy(GEN x);
+GEN     mkhashmap(void);
 GEN     mkmap(void);
 GEN     normalize(GEN x);
 GEN     normalizepol(GEN x);
@@ -3382,9 +3407,14 @@ GEN     usumdivkvec(ulong n, GEN K);
 long    timer_delay(pari_timer *T);
 long    timer_get(pari_timer *T);
 void    timer_start(pari_timer *T);
+long    walltimer_delay(pari_timer *T);
+long    walltimer_get(pari_timer *T);
+void    walltimer_start(pari_timer *T);
 int     chk_gerepileupto(GEN x);
 GENbin* copy_bin(GEN x);
 GENbin* copy_bin_canon(GEN x);
+GENbin* copy_bin_flat(GEN x);
+GENbin* copy_bin_ref(GEN x, pari_sp *R, long n);
 void    dbg_gerepile(pari_sp av);
 void    dbg_gerepileupto(GEN q);
 GEN     errname(GEN err);
@@ -3396,11 +3426,15 @@ GEN     gcopy_avma(GEN x, pari_sp *AVMA);
 GEN     gcopy_lg(GEN x, long lx);
 GEN     gerepile(pari_sp ltop, pari_sp lbot, GEN q);
 void    gerepileallsp(pari_sp av, pari_sp tetpil, int n, ...);
+void    gerepileall_young(pari_sp av, int n, ...);
 void    gerepilecoeffssp(pari_sp av, pari_sp tetpil, long *g, int n);
 void    gerepilemanysp(pari_sp av, pari_sp tetpil, GEN* g[], int n);
 GEN     getheap(void);
+GEN     getheap0(long flag);
 void    gp_context_save(struct gp_context* rec);
 void    gp_context_restore(struct gp_context* rec);
+GEN     gpromote(pari_stack *s, GEN x);
+void    gpromote_release(pari_stack *s);
 long    gsizeword(GEN x);
 long    gsizebyte(GEN x);
 void    gunclone(GEN x);
@@ -3441,11 +3475,15 @@ void    pari_thread_alloc(struct pari_thread *t, size_t s, GEN arg);
 void    pari_thread_close(void);
 void    pari_thread_free(struct pari_thread *t);
 void    pari_thread_init(void);
+void    pari_thread_resync(void);
 GEN     pari_thread_start(struct pari_thread *t);
 void    pari_thread_sync(void);
 void    pari_thread_valloc(struct pari_thread *t, size_t s, size_t v, GEN arg);
+size_t  pari_thread_vsize(size_t s);
 GEN     pari_version(void);
 void    pari_warn(int numerr, ...);
+void    paristack_hwm_reset(void);
+ulong   paristack_hwm(void);
 void    paristack_newrsize(ulong newsize);
 void    paristack_resize(ulong newsize);
 void    paristack_setsize(size_t rsize, size_t vsize);
@@ -3454,9 +3492,11 @@ void    parivstack_reset(void);
 GEN     trap0(const char *e, GEN f, GEN r);
 void    shiftaddress(GEN x, long dec);
 void    shiftaddress_canon(GEN x, long dec);
+void    shiftaddress_ref(GEN x, long dec);
 long    timer(void);
 long    timer2(void);
 void    traverseheap( void(*f)(GEN, void *), void *data );
+void    write_bin_canon(GEN x, void *E, void (*wr)(void *E, GEN w, long n));
 
 /* intnum.c */
 
@@ -3589,6 +3629,7 @@ GEN     qflllgram0(GEN x, long flag);
 /* map.c */
 
 GEN     gtomap(GEN M);
+GEN     gtomap0(GEN M, long flag);
 void    mapdelete(GEN T, GEN a);
 GEN     mapdomain(GEN T);
 GEN     mapdomain_shallow(GEN T);
@@ -3838,8 +3879,10 @@ void    mt_sigint_block(void);
 void    mt_sigint_unblock(void);
 void    mt_queue_end(struct pari_mt *pt);
 GEN     mt_queue_get(struct pari_mt *pt, long *jobid, long *pending);
+GEN     mt_queue_share(struct pari_mt *pt, GEN x);
 void    mt_queue_start(struct pari_mt *pt, GEN worker);
 void    mt_queue_submit(struct pari_mt *pt, long jobid, GEN work);
+ulong   mt_stack_hwm(void);
 void    pari_mt_init(void);
 void    pari_mt_close(void);
 
@@ -4053,6 +4096,7 @@ int     uisprime_101(ulong n);
 int     uisprime_661(ulong n);
 ulong   uprime(long n);
 ulong   uprimepi(ulong n);
+GEN     zv_isprime(GEN v);
 
 /* qfisom.c */
 
@@ -152,7 +152,8 @@ typedef long *GEN;
 #define list_data(x) ((GEN*)x)[2]
 enum {
   t_LIST_RAW = 0,
-  t_LIST_MAP = 1
+  t_LIST_MAP = 1,
+  t_LIST_HASHMAP = 2
 };
 
 /* DO NOT REORDER THESE
@@ -2580,6 +2580,7 @@ INLINE GEN
 bnf_get_fu(GEN bnf) {
   GEN fu = bnf_get_fu_nocheck(bnf);
   if (typ(fu) == t_MAT) pari_err(e_MISC,"missing units in bnf");
+  if (typ(fu) == t_INT) fu = bnf_build_fu(bnf); /* lazy bnf */
   return fu;
 }
 INLINE GEN
@@ -84,7 +84,8 @@ enum {
   nf_PARTIALFACT = 16,
   nf_ROUND2 = 64, /* obsolete */
   nf_ADDZK =  256,
-  nf_GEN_IF_PRINCIPAL = 512
+  nf_GEN_IF_PRINCIPAL = 512,
+  nf_LAZY = 1024
 };
 
 enum {
@@ -23,8 +23,9 @@ typedef int (*QSCOMP)(const void *, const void *);
 #define numberof(x) (sizeof(x) / sizeof((x)[0]))
 
 /* to manipulate 'blocs' */
-#define BL_HEAD 4
+#define BL_HEAD 5
 #define bl_base(x) (void*)((x) - BL_HEAD)
+#define bl_class(x) (((GEN)x)[-5])
 #define bl_refc(x) (((GEN)x)[-4])
 #define bl_next(x) (((GEN*)x)[-3])
 #define bl_prev(x) (((GEN*)x)[-2])
@@ -118,15 +119,20 @@ void mt_sigint(void);
 void mt_err_recover(long er);
 void mt_init_stack(size_t s);
 int  mt_is_thread(void);
+void mt_lock(void);
+void mt_unlock(void);
 GEN  parapply_worker(GEN d, GEN code);
 GEN  pareval_worker(GEN code);
 void parfor0(GEN a, GEN b, GEN code, GEN code2);
-GEN  parfor_worker(GEN i, GEN C);
+GEN  parfor_worker(GEN V, GEN C);
 void parforprime0(GEN a, GEN b, GEN code, GEN code2);
 void parforvec0(GEN a, GEN code, GEN code2, long flag);
 GEN  parvector_worker(GEN i, GEN C);
 GEN  polmodular_worker(ulong p, ulong t, ulong L, GEN hilb, GEN factu,
        GEN vne, GEN vinfo, long compute_derivs, GEN j_powers, GEN fdb);
+GEN  convi_worker(GEN x, GEN vP, GEN vI);
+GEN  fromdigitsu_worker(GEN x, GEN B);
+GEN  muliifft_worker(GEN A, GEN B, GEN M, ulong o, ulong ord, long k);
 GEN  nmV_polint_center_tree_worker(GEN Va, GEN T, GEN R, GEN xa, GEN m2);
 GEN  ZX_resultant_worker(GEN P, GEN A, GEN B, GEN dB);
 
@@ -273,6 +279,7 @@ void  resetout(int initerr);
 void  init_linewrap(long w);
 void  print_functions_hash(const char *s);
 GEN   readbin(const char *name, FILE *f, int *vector);
+int   isbinmapped(GEN x);
 int   term_height(void);
 int   term_width(void);
 /* gp_colors */
@@ -317,7 +324,11 @@ void forpath_init(forpath_t *T, gp_path *path, const char *s);
 char *forpath_next(forpath_t *T);
 
 /* GP output && output format */
-void gpwritebin(const char *s, GEN x);
+void gpwritebin(const char *s, GEN x, long flag);
+void gpwritebinkey(const char *s, GEN K, GEN X, long flag);
+void gpseadata_tobin(const char *s);
+void binfile_unlink(const char *name);
+char *wr_check(const char *s);
 extern char *current_logfile;
 
 /* colors */
@@ -527,6 +538,7 @@ void pari_pthread_init_varstate();
 void pari_thread_close_files(void);
 void pari_thread_init_seadata(void);
 void pari_thread_init_varstate();
+void pari_thread_sync_varstate(void);
 
 /* BY FILES */
 
@@ -715,6 +727,8 @@ int     Fl_MR_Jaeschke(ulong n, long k);
 int     MR_Jaeschke(GEN n, long k);
 long    isanypower_nosmalldiv(GEN N, GEN *px);
 void    prime_table_next_p(ulong a, byteptr *pd, ulong *pp, ulong *pn);
+void    uisprime_batch(const ulong *n, long k, long *r);
+ulong   uprimes_batch(ulong a, ulong b, ulong *P);
 
 /* perm.c */
 
@@ -47,7 +47,7 @@ typedef struct {
                          * end <= sieveb = min(bb, maxprime^2, ULONG_MAX) */
   ulong pos, maxpos; /* current cell and max cell */
 
-  /* strategy 3: unextprime, use p */
+  /* strategy 3: unextprime, use p, a (last integer scanned) and cache */
 
   /* strategy 4: nextprime */
   GEN pp;
@@ -86,6 +86,8 @@ struct pari_mainstack
 {
   pari_sp top, bot, vbot;
   size_t size, rsize, vsize, memused;
+  pari_sp hwm; /* lowest avma since the last paristack_hwm_reset */
+  pari_sp lim; /* new_chunk calls new_chunk_resize below lim >= bot */
 };
 
 extern THREAD struct pari_mainstack *pari_mainstack;
@@ -254,6 +256,7 @@ typedef struct {
   pari_timer *T;
   ulong primelimit; /* deprecated */
   ulong threadsizemax, threadsize;
+  char *stackfile, *primetablefile;
 } gp_data;
 extern gp_data *GP_DATA;
 
@@ -5,6 +5,7 @@ extern long AGM_ATAN_LIMIT;
 extern long DIVRR_GMP_LIMIT;
 extern long EXPNEWTON_LIMIT;
 extern long F2x_MUL_KARATSUBA_LIMIT;
+extern long FROMDIGITS_PARALLEL_LIMIT;
 extern long Flx_BARRETT_QUARTMULII_LIMIT;
 extern long Flx_BARRETT_HALFMULII_LIMIT;
 extern long Flx_BARRETT_KARATSUBA_LIMIT;
@@ -28,6 +29,7 @@ extern long Flx_MUL_HALFMULII_LIMIT;
 extern long Flx_MUL_KARATSUBA_LIMIT;
 extern long Flx_MUL_MULII2_LIMIT;
 extern long Flx_MUL_MULII_LIMIT;
+extern long Flx_MULTIEVAL_LIMIT;
 extern long Flx_REM_BARRETT_LIMIT;
 extern long Flx_SQR_QUARTSQRI_LIMIT;
 extern long Flx_SQR_HALFSQRI_LIMIT;
@@ -47,6 +49,7 @@ extern long FpX_EXTGCD_LIMIT;
 extern long FpX_GCD_LIMIT;
 extern long FpX_HALFGCD_LIMIT;
 extern long FpX_INVBARRETT_LIMIT;
+extern long FpX_MULTIEVAL_LIMIT;
 extern long FpX_REM_BARRETT_LIMIT;
 extern long FpXQX_BARRETT_LIMIT;
 extern long FpXQX_DIVREM_BARRETT_LIMIT;
@@ -54,6 +57,7 @@ extern long FpXQX_EXTGCD_LIMIT;
 extern long FpXQX_GCD_LIMIT;
 extern long FpXQX_HALFGCD_LIMIT;
 extern long FpXQX_INVBARRETT_LIMIT;
+extern long FpXQX_MULTIEVAL_LIMIT;
 extern long FpXQX_REM_BARRETT_LIMIT;
 extern long Fp_POW_BARRETT_LIMIT;
 extern long Fp_POW_REDC_LIMIT;
@@ -62,6 +66,7 @@ extern long INVNEWTON_LIMIT;
 extern long LOGAGMCX_LIMIT;
 extern long LOGAGM_LIMIT;
 extern long MULII_FFT_LIMIT;
+extern long MULII_FFT_PARALLEL_LIMIT;
 extern long MULII_KARATSUBA_LIMIT;
 extern long MULRR_MULII_LIMIT;
 extern long RgX_MUL_LIMIT;
@@ -73,6 +78,7 @@ extern long SQRI_KARATSUBA_LIMIT;
 #  define DIVRR_GMP_LIMIT                __DIVRR_GMP_LIMIT
 #  define EXPNEWTON_LIMIT                __EXPNEWTON_LIMIT
 #  define F2x_MUL_KARATSUBA_LIMIT        __F2x_MUL_KARATSUBA_LIMIT
+#  define FROMDIGITS_PARALLEL_LIMIT      __FROMDIGITS_PARALLEL_LIMIT
 #  define Flx_BARRETT_QUARTMULII_LIMIT   __Flx_BARRETT_QUARTMULII_LIMIT
 #  define Flx_BARRETT_HALFMULII_LIMIT    __Flx_BARRETT_HALFMULII_LIMIT
 #  define Flx_BARRETT_KARATSUBA_LIMIT    __Flx_BARRETT_KARATSUBA_LIMIT
@@ -96,6 +102,7 @@ extern long SQRI_KARATSUBA_LIMIT;
 #  define Flx_MUL_KARATSUBA_LIMIT        __Flx_MUL_KARATSUBA_LIMIT
 #  define Flx_MUL_MULII2_LIMIT           __Flx_MUL_MULII2_LIMIT
 #  define Flx_MUL_MULII_LIMIT            __Flx_MUL_MULII_LIMIT
+#  define Flx_MULTIEVAL_LIMIT            __Flx_MULTIEVAL_LIMIT
 #  define Flx_REM_BARRETT_LIMIT          __Flx_REM_BARRETT_LIMIT
 #  define Flx_SQR_QUARTSQRI_LIMIT        __Flx_SQR_QUARTSQRI_LIMIT
 #  define Flx_SQR_HALFSQRI_LIMIT         __Flx_SQR_HALFSQRI_LIMIT
@@ -115,6 +122,7 @@ extern long SQRI_KARATSUBA_LIMIT;
 #  define FpX_GCD_LIMIT                  __FpX_GCD_LIMIT
 #  define FpX_HALFGCD_LIMIT              __FpX_HALFGCD_LIMIT
 #  define FpX_INVBARRETT_LIMIT           __FpX_INVBARRETT_LIMIT
+#  define FpX_MULTIEVAL_LIMIT            __FpX_MULTIEVAL_LIMIT
 #  define FpX_REM_BARRETT_LIMIT          __FpX_REM_BARRETT_LIMIT
 #  define FpXQX_BARRETT_LIMIT            __FpXQX_BARRETT_LIMIT
 #  define FpXQX_DIVREM_BARRETT_LIMIT     __FpXQX_DIVREM_BARRETT_LIMIT
@@ -122,6 +130,7 @@ extern long SQRI_KARATSUBA_LIMIT;
 #  define FpXQX_GCD_LIMIT                __FpXQX_GCD_LIMIT
 #  define FpXQX_HALFGCD_LIMIT            __FpXQX_HALFGCD_LIMIT
 #  define FpXQX_INVBARRETT_LIMIT         __FpXQX_INVBARRETT_LIMIT
+#  define FpXQX_MULTIEVAL_LIMIT          __FpXQX_MULTIEVAL_LIMIT
 #  define FpXQX_REM_BARRETT_LIMIT        __FpXQX_REM_BARRETT_LIMIT
 #  define Fp_POW_BARRETT_LIMIT           __Fp_POW_BARRETT_LIMIT
 #  define Fp_POW_REDC_LIMIT              __Fp_POW_REDC_LIMIT
@@ -130,6 +139,7 @@ extern long SQRI_KARATSUBA_LIMIT;
 #  define LOGAGMCX_LIMIT                 __LOGAGMCX_LIMIT
 #  define LOGAGM_LIMIT                   __LOGAGM_LIMIT
 #  define MULII_FFT_LIMIT                __MULII_FFT_LIMIT
+#  define MULII_FFT_PARALLEL_LIMIT       __MULII_FFT_PARALLEL_LIMIT
 #  define MULII_KARATSUBA_LIMIT          __MULII_KARATSUBA_LIMIT
 #  define MULRR_MULII_LIMIT              __MULRR_MULII_LIMIT
 #  define RgX_MUL_LIMIT                  __RgX_MUL_LIMIT
@@ -1221,6 +1221,15 @@ sqrispec(GEN x, long nx)
   return zd;
 }
 
+/* Only used by the native kernel FFT multiplication */
+GEN
+muliifft_worker(GEN A, GEN B, GEN M, ulong o, ulong ord, long k)
+{
+  (void)A; (void)B; (void)M; (void)o; (void)ord; (void)k;
+  pari_err_BUG("muliifft_worker [GMP kernel]");
+  return NULL; /* NOT REACHED */
+}
+
 INLINE GEN
 sqrispec_mirror(GEN x, long nx)
 {
@@ -1377,6 +1386,15 @@ int_normalize(GEN x, long known_zero_words)
  **                                                                **
  ********************************************************************/
 
+/* Only used by the native kernel base conversion */
+GEN
+convi_worker(GEN x, GEN vP, GEN vI)
+{
+  (void)x; (void)vP; (void)vI;
+  pari_err_BUG("convi_worker [GMP kernel]");
+  return NULL; /* NOT REACHED */
+}
+
 ulong *
 convi(GEN x, long *l)
 {
@@ -3,6 +3,7 @@
 #define __DIVRR_GMP_LIMIT                4
 #define __EXPNEWTON_LIMIT                66
 #define __F2x_MUL_KARATSUBA_LIMIT        15
+#define __FROMDIGITS_PARALLEL_LIMIT      50000
 #define __Flx_BARRETT_HALFMULII_LIMIT    21
 #define __Flx_BARRETT_KARATSUBA_LIMIT    1172
 #define __Flx_BARRETT_MULII2_LIMIT       16
@@ -21,6 +22,7 @@
 #define __Flx_INVBARRETT_MULII2_LIMIT    26
 #define __Flx_INVBARRETT_MULII_LIMIT     1154
 #define __Flx_INVBARRETT_QUARTMULII_LIMIT 139
+#define __Flx_MULTIEVAL_LIMIT            39
 #define __Flx_MUL_HALFMULII_LIMIT        5
 #define __Flx_MUL_KARATSUBA_LIMIT        142
 #define __Flx_MUL_MULII2_LIMIT           5
@@ -45,6 +47,7 @@
 #define __FpXQX_GCD_LIMIT                191
 #define __FpXQX_HALFGCD_LIMIT            35
 #define __FpXQX_INVBARRETT_LIMIT         40
+#define __FpXQX_MULTIEVAL_LIMIT          10
 #define __FpXQX_REM_BARRETT_LIMIT        30
 #define __FpX_BARRETT_LIMIT              38
 #define __FpX_DIVREM_BARRETT_LIMIT       113
@@ -52,6 +55,7 @@
 #define __FpX_GCD_LIMIT                  406
 #define __FpX_HALFGCD_LIMIT              58
 #define __FpX_INVBARRETT_LIMIT           111
+#define __FpX_MULTIEVAL_LIMIT            16
 #define __FpX_REM_BARRETT_LIMIT          111
 #define __Fp_POW_BARRETT_LIMIT           127
 #define __Fp_POW_REDC_LIMIT              17
@@ -60,6 +64,7 @@
 #define __LOGAGMCX_LIMIT                 22
 #define __LOGAGM_LIMIT                   6
 #define __MULII_FFT_LIMIT                -1
+#define __MULII_FFT_PARALLEL_LIMIT       -1
 #define __MULII_KARATSUBA_LIMIT          -1
 #define __MULRR_MULII_LIMIT              74
 #define __RgX_MUL_LIMIT                  9
@@ -71,6 +76,7 @@
 #define __DIVRR_GMP_LIMIT                4
 #define __EXPNEWTON_LIMIT                197
 #define __F2x_MUL_KARATSUBA_LIMIT        23
+#define __FROMDIGITS_PARALLEL_LIMIT      100000
 #define __Flx_BARRETT_HALFMULII_LIMIT    23
 #define __Flx_BARRETT_KARATSUBA_LIMIT    905
 #define __Flx_BARRETT_MULII2_LIMIT       647
@@ -89,6 +95,7 @@
 #define __Flx_INVBARRETT_MULII2_LIMIT    1815
 #define __Flx_INVBARRETT_MULII_LIMIT     1293
 #define __Flx_INVBARRETT_QUARTMULII_LIMIT 73
+#define __Flx_MULTIEVAL_LIMIT            45
 #define __Flx_MUL_HALFMULII_LIMIT        7
 #define __Flx_MUL_KARATSUBA_LIMIT        90
 #define __Flx_MUL_MULII2_LIMIT           152
@@ -113,6 +120,7 @@
 #define __FpXQX_GCD_LIMIT                182
 #define __FpXQX_HALFGCD_LIMIT            35
 #define __FpXQX_INVBARRETT_LIMIT         40
+#define __FpXQX_MULTIEVAL_LIMIT          10
 #define __FpXQX_REM_BARRETT_LIMIT        30
 #define __FpX_BARRETT_LIMIT              44
 #define __FpX_DIVREM_BARRETT_LIMIT       116
@@ -120,6 +128,7 @@
 #define __FpX_GCD_LIMIT                  414
 #define __FpX_HALFGCD_LIMIT              55
 #define __FpX_INVBARRETT_LIMIT           121
+#define __FpX_MULTIEVAL_LIMIT            18
 #define __FpX_REM_BARRETT_LIMIT          127
 #define __Fp_POW_BARRETT_LIMIT           11
 #define __Fp_POW_REDC_LIMIT              3
@@ -128,6 +137,7 @@
 #define __LOGAGMCX_LIMIT                 32
 #define __LOGAGM_LIMIT                   45
 #define __MULII_FFT_LIMIT                -1
+#define __MULII_FFT_PARALLEL_LIMIT       -1
 #define __MULII_KARATSUBA_LIMIT          -1
 #define __MULRR_MULII_LIMIT              8
 #define __RgX_MUL_LIMIT                  7
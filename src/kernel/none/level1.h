@@ -103,7 +103,7 @@ new_chunk(size_t x) /* x is a number of longs */
 {
   GEN z = ((GEN) avma) - x;
   CHECK_CTRLC
-  if (x > (avma-pari_mainstack->bot) / sizeof(long))
+  if (x > (avma-pari_mainstack->lim) / sizeof(long))
     new_chunk_resize(x);
   avma = (pari_sp)z;
 #ifdef MEMSTEP
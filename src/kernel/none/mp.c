@@ -1447,13 +1447,13 @@ Zf_sqr(GEN a, GEN M) { return Zf_red_destroy(sqri(a), M); }
 INLINE GEN
 Zf_mul(GEN a, GEN b, GEN M) { return Zf_red_destroy(mulii(a,b), M); }
 
-/* In place, bit reversing FFT */
+/* One butterfly layer of muliifft_dit */
 static void
-muliifft_dit(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
+muliifft_dit_step(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
 {
   pari_sp av = avma;
   long i;
-  ulong j, no = (o<<1)%ord;
+  ulong j;
   long hstep=step>>1;
   for (i = d+1, j = 0; i <= d+hstep; ++i, j =(j+o)%ord)
   {
@@ -1463,6 +1463,15 @@ muliifft_dit(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
     affii(b,gel(FFT,i+hstep));
     avma = av;
   }
+}
+
+/* In place, bit reversing FFT */
+static void
+muliifft_dit(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
+{
+  ulong no = (o<<1)%ord;
+  long hstep=step>>1;
+  muliifft_dit_step(o, ord, M, FFT, d, step);
   if (hstep>1)
   {
     muliifft_dit(no, ord, M, FFT, d, hstep);
@@ -1470,19 +1479,14 @@ muliifft_dit(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
   }
 }
 
-/* In place, bit reversed FFT, inverse of muliifft_dit */
+/* One butterfly layer of muliifft_dis */
 static void
-muliifft_dis(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
+muliifft_dis_step(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
 {
   pari_sp av = avma;
   long i;
-  ulong j, no = (o<<1)%ord;
+  ulong j;
   long hstep=step>>1;
-  if (hstep>1)
-  {
-    muliifft_dis(no, ord, M, FFT, d, hstep);
-    muliifft_dis(no, ord, M, FFT, d+hstep, hstep);
-  }
   for (i = d+1, j = 0; i <= d+hstep; ++i, j =(j+o)%ord)
   {
     GEN z = Zf_mulsqrt2(gel(FFT,i+hstep), j, ord, M);
@@ -1494,6 +1498,20 @@ muliifft_dis(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
   }
 }
 
+/* In place, bit reversed FFT, inverse of muliifft_dit */
+static void
+muliifft_dis(ulong o, ulong ord, GEN M, GEN FFT, long d, long step)
+{
+  ulong no = (o<<1)%ord;
+  long hstep=step>>1;
+  if (hstep>1)
+  {
+    muliifft_dis(no, ord, M, FFT, d, hstep);
+    muliifft_dis(no, ord, M, FFT, d+hstep, hstep);
+  }
+  muliifft_dis_step(o, ord, M, FFT, d, step);
+}
+
 static GEN
 muliifft_spliti(GEN a, long na, long bs, long n, long mod)
 {
@@ -1547,6 +1565,105 @@ muliifft_unspliti(GEN V, long bs, long len)
   return int_normalize(a,0);
 }
 
+/* Copy of the FFT blocks in V, with room for in place arithmetic mod M */
+static GEN
+muliifft_realloc(GEN V, long mod)
+{
+  long i, l = lg(V);
+  GEN W = cgetg(l, t_VEC);
+  for (i = 1; i < l; i++)
+  {
+    gel(W,i) = cgeti(mod+3);
+    affii(gel(V,i), gel(W,i));
+  }
+  return W;
+}
+
+/* A (and B if not t_INT): a slice of a transform after its top layers,
+ * o: root of unity for that slice. Transform the slice down, multiply
+ * pointwise (square if B is a t_INT), transform back and apply the final
+ * normalization (which commutes with the remaining top layers) */
+GEN
+muliifft_worker(GEN A, GEN B, GEN M, ulong o, ulong ord, long k)
+{
+  pari_sp av;
+  long i, n = lg(A)-1, mod = lgefint(M)-3;
+  GEN FFT = muliifft_realloc(A, mod);
+  av = avma;
+  muliifft_dit(o, ord, M, FFT, 0, n);
+  if (typ(B) == t_INT)
+    for(i=1; i<=n; i++)
+    {
+      affii(Zf_sqr(gel(FFT,i), M), gel(FFT,i));
+      avma=av;
+    }
+  else
+  {
+    GEN FFTb = muliifft_realloc(B, mod);
+    pari_sp av2 = avma;
+    muliifft_dit(o, ord, M, FFTb, 0, n);
+    for(i=1; i<=n; i++)
+    {
+      affii(Zf_mul(gel(FFT,i), gel(FFTb,i), M), gel(FFT,i));
+      avma=av2;
+    }
+  }
+  avma=av;
+  muliifft_dis(ord-o, ord, M, FFT, 0, n);
+  for(i=1; i<=n; i++)
+  {
+    affii(Zf_shift(gel(FFT,i), (ord>>1)-k, M), gel(FFT,i));
+    avma=av;
+  }
+  return FFT;
+}
+
+/* Parallel version of the transform, pointwise product and inverse
+ * transform in muliispec_fft (sqrispec_fft if FFTb = NULL). The top layers
+ * are done here, the 2^j independent sub-transforms below them are
+ * dispatched to muliifft_worker. Result is left in FFT */
+static void
+muliifft_mt(ulong o, ulong ord, GEN M, GEN FFT, GEN FFTb, long k, long n)
+{
+  pari_sp av = avma;
+  long i, l, d, step, pending = 0;
+  long j = minss(expu(pari_mt_nbthreads-1)+1, k-1), m = 1L<<j, s = n>>j;
+  ulong oj;
+  struct pari_mt pt;
+  GEN worker;
+  for (l = 0, step = n, oj = o; l < j; l++, step >>= 1, oj = (oj<<1)%ord)
+    for (d = 0; d < n; d += step)
+    {
+      muliifft_dit_step(oj, ord, M, FFT, d, step);
+      if (FFTb) muliifft_dit_step(oj, ord, M, FFTb, d, step);
+    }
+  worker = strtoclosure("_muliifft_worker", 4, M, utoi(oj), utoi(ord), stoi(k));
+  mt_queue_start(&pt, worker);
+  for (i = 1; i <= m || pending; i++)
+  {
+    pari_sp av2 = avma;
+    long workid;
+    GEN done, work = NULL;
+    if (i <= m)
+    {
+      GEN A = vecslice(FFT, (i-1)*s+1, i*s);
+      GEN B = FFTb ? vecslice(FFTb, (i-1)*s+1, i*s): gen_0;
+      work = mkvec2(A, B);
+    }
+    mt_queue_submit(&pt, i, work);
+    done = mt_queue_get(&pt, &workid, &pending);
+    if (done)
+      for (l = 1; l <= s; l++)
+        affii(gel(done,l), gel(FFT,(workid-1)*s+l));
+    avma = av2;
+  }
+  mt_queue_end(&pt);
+  for (l = j-1; l >= 0; l--)
+    for (d = 0, step = n>>l; d < n; d += step)
+      muliifft_dis_step(ord-(o<<l), ord, M, FFT, d, step);
+  avma = av;
+}
+
 static GEN
 sqrispec_fft(GEN a, long na)
 {
@@ -1562,8 +1679,13 @@ sqrispec_fft(GEN a, long na)
   M = int2n(mod*BITS_IN_LONG);
   M[2+mod] = 1;
   FFT = muliifft_spliti(a, na, bs, n, mod);
-  muliifft_dit(o, ord, M, FFT, 0, n);
   av = avma;
+  if (na >= MULII_FFT_PARALLEL_LIMIT && pari_mt_nbthreads > 1 && !mt_is_thread())
+  {
+    muliifft_mt(o, ord, M, FFT, NULL, k, n);
+    return gerepileuptoint(ltop, muliifft_unspliti(FFT,bs,2+len));
+  }
+  muliifft_dit(o, ord, M, FFT, 0, n);
   for(i=1; i<=n; i++)
   {
     affii(Zf_sqr(gel(FFT,i), M), gel(FFT,i));
@@ -1593,6 +1715,12 @@ muliispec_fft(GEN a, GEN b, long na, long nb)
   M = int2n(mod*BITS_IN_LONG);
   M[2+mod] = 1;
   FFT = muliifft_spliti(a, na, bs, n, mod);
+  if (nb >= MULII_FFT_PARALLEL_LIMIT && pari_mt_nbthreads > 1 && !mt_is_thread())
+  {
+    FFTb = muliifft_spliti(b, nb, bs, n, mod);
+    muliifft_mt(o, ord, M, FFT, FFTb, k, n);
+    return gerepileuptoint(ltop, muliifft_unspliti(FFT,bs,2+len));
+  }
   av=avma;
   muliifft_dit(o, ord, M, FFT, 0, n);
   FFTb = muliifft_spliti(b, nb, bs, n, mod);
@@ -2154,26 +2282,136 @@ sqrtr_abs(GEN x)
  *                                                                 *
  *******************************************************************/
 
+/* vP[i] = 10^(9*2^(i-1)), i <= k; vI[i] approximates 1/vP[i] to the size
+ * of vP[i] if the latter is large enough for Newton division to pay off, and
+ * is gen_0 otherwise. vI[k] is not cached: vP[k] is used at most once */
+static void
+convi_powers(long k, GEN *pvP, GEN *pvI)
+{
+  GEN vP = cgetg(k+1, t_VEC), vI = cgetg(k+1, t_VEC);
+  long i;
+  for (i = 1; i <= k; i++)
+  {
+    GEN P = i==1 ? utoipos(1000000000UL): sqri(gel(vP,i-1));
+    long l = lgefint(P);
+    gel(vP,i) = P;
+    gel(vI,i) = i < k && l > INVNEWTON_LIMIT ? invr(itor(P, l+1)): gen_0;
+  }
+  *pvP = vP; *pvI = vI;
+}
+
+/* x < P^2, return x \\ P and set *r = x % P, I from convi_powers. An
+ * approximation of 1/P to the size of x \\ P is enough for the quotient
+ * to be off by a few units at most */
+static GEN
+convi_divrem(GEN x, GEN P, GEN I, GEN *r)
+{
+  pari_sp av = avma;
+  GEN q;
+  if (typ(I) != t_REAL)
+  {
+    long l = lgefint(x) - lgefint(P) + 3;
+    if (l <= INVNEWTON_LIMIT) return dvmdii(x, P, r);
+    I = invr(itor(P, l));
+  }
+  q = gerepileuptoint(av, truncr(mulir(x, I)));
+  *r = subii(x, mulii(q, P));
+  while (signe(*r) < 0) { q = subiu(q, 1); *r = addii(*r, P); }
+  while (cmpii(*r, P) >= 0) { q = addiu(q, 1); *r = subii(*r, P); }
+  gerepileall(av, 2, &q, r);
+  return q;
+}
+
+/* 0 <= x < 10^(9*2^k): write its 2^k digits in base 10^9 to res[0..2^k-1],
+ * least significant first */
+static void
+convi_dac(GEN x, long k, GEN vP, GEN vI, ulong *res)
+{
+  pari_sp av = avma;
+  long m;
+  GEN q, r;
+  if (!k) { *res = itou(x); return; }
+  m = 1L<<(k-1);
+  if (!signe(x)) { memset(res, 0, 2*m*sizeof(ulong)); return; }
+  q = convi_divrem(x, gel(vP,k), gel(vI,k), &r);
+  convi_dac(r, k-1, vP, vI, res);
+  convi_dac(q, k-1, vP, vI, res+m);
+  avma = av;
+}
+
+/* x < 10^(9*2^k) with k = #vP: its 2^k digits in base 10^9 as a t_VECSMALL */
+GEN
+convi_worker(GEN x, GEN vP, GEN vI)
+{
+  long k = lg(vP)-1;
+  GEN z = cgetg((1L<<k)+1, t_VECSMALL);
+  convi_dac(x, k, vP, vI, (ulong*)(z+1));
+  return z;
+}
+
+/* Parallel convi_dac: split x into 2^j chunks and convert them in parallel */
+static void
+convi_mt(GEN x, long k, GEN vP, GEN vI, ulong *res)
+{
+  pari_sp av = avma;
+  long i, l, pending = 0;
+  long j = minss(expu(pari_mt_nbthreads-1)+1, k), m = 1L<<j, s = 1L<<(k-j);
+  struct pari_mt pt;
+  GEN worker, V = mkvec(x);
+  for (l = k; l > k-j; l--)
+  {
+    long n = lg(V)-1;
+    GEN W = cgetg(2*n+1, t_VEC);
+    for (i = 1; i <= n; i++)
+      gel(W,2*i) = convi_divrem(gel(V,i), gel(vP,l), gel(vI,l), &gel(W,2*i-1));
+    V = W;
+  }
+  worker = strtoclosure("_convi_worker", 2, vecslice(vP,1,k-j), vecslice(vI,1,k-j));
+  mt_queue_start(&pt, worker);
+  for (i = 1; i <= m || pending; i++)
+  {
+    pari_sp av2 = avma;
+    long workid;
+    GEN done;
+    mt_queue_submit(&pt, i, i <= m ? mkvec(gel(V,i)): NULL);
+    done = mt_queue_get(&pt, &workid, &pending);
+    if (done)
+      for (l = 0; l < s; l++) res[(workid-1)*s+l] = uel(done,l+1);
+    avma = av2;
+  }
+  mt_queue_end(&pt);
+  avma = av;
+}
+
+/* 0 <= x < 10^(9*l): write its l digits in base 10^9 to res[0..l-1].
+ * Peel off blocks of 2^k digits, 2^k < l maximal, using convi_dac */
 static void
-convi_dac(GEN x, ulong l, ulong *res)
+convi_top(GEN x, long l, GEN vP, GEN vI, ulong *res)
 {
-  pari_sp ltop=avma;
-  ulong m;
-  GEN x1,x2;
-  if (l==1) { *res=itou(x); return; }
-  m=l>>1;
-  x1=dvmdii(x,powuu(1000000000UL,m),&x2);
-  convi_dac(x1,l-m,res+m);
-  convi_dac(x2,m,res);
-  avma=ltop;
+  pari_sp av = avma;
+  int mt = pari_mt_nbthreads > 1 && !mt_is_thread();
+  while (l > 1)
+  {
+    long k = expu(l-1), m = 1L<<k;
+    GEN r, q = convi_divrem(x, gel(vP,k+1), gel(vI,k+1), &r);
+    if (mt && lgefint(r) >= MULII_FFT_PARALLEL_LIMIT)
+      convi_mt(r, k, vP, vI, res);
+    else
+      convi_dac(r, k, vP, vI, res);
+    x = q; res += m; l -= m;
+  }
+  *res = itou(x);
+  avma = av;
 }
 
 /* convert integer --> base 10^9 [not memory clean] */
 ulong *
 convi(GEN x, long *l)
 {
+  pari_sp av;
   long lz, lx = lgefint(x);
   ulong *z;
+  GEN vP, vI;
   if (lx == 3 && uel(x,2) < 1000000000UL) {
     z = (ulong*)new_chunk(1);
     *z = x[2];
@@ -2181,7 +2419,10 @@ convi(GEN x, long *l)
   }
   lz = 1 + (long)bit_accuracy_mul(lx, LOG10_2/9);
   z = (ulong*)new_chunk(lz);
-  convi_dac(x,(ulong)lz,z);
+  av = avma;
+  convi_powers(expu(lz-1)+1, &vP, &vI);
+  convi_top(absi_shallow(x), lz, vP, vI, z);
+  avma = av;
   while (z[lz-1]==0) lz--;
   *l=lz; return z+lz;
 }
@@ -3,6 +3,7 @@ long AGM_ATAN_LIMIT                 = __AGM_ATAN_LIMIT;
 long DIVRR_GMP_LIMIT                = __DIVRR_GMP_LIMIT;
 long EXPNEWTON_LIMIT                = __EXPNEWTON_LIMIT;
 long F2x_MUL_KARATSUBA_LIMIT        = __F2x_MUL_KARATSUBA_LIMIT;
+long FROMDIGITS_PARALLEL_LIMIT      = __FROMDIGITS_PARALLEL_LIMIT;
 long Flx_BARRETT_QUARTMULII_LIMIT   = __Flx_BARRETT_QUARTMULII_LIMIT;
 long Flx_BARRETT_HALFMULII_LIMIT    = __Flx_BARRETT_HALFMULII_LIMIT;
 long Flx_BARRETT_KARATSUBA_LIMIT    = __Flx_BARRETT_KARATSUBA_LIMIT;
@@ -26,6 +27,7 @@ long Flx_MUL_HALFMULII_LIMIT        = __Flx_MUL_HALFMULII_LIMIT;
 long Flx_MUL_KARATSUBA_LIMIT        = __Flx_MUL_KARATSUBA_LIMIT;
 long Flx_MUL_MULII2_LIMIT           = __Flx_MUL_MULII2_LIMIT;
 long Flx_MUL_MULII_LIMIT            = __Flx_MUL_MULII_LIMIT;
+long Flx_MULTIEVAL_LIMIT            = __Flx_MULTIEVAL_LIMIT;
 long Flx_REM_BARRETT_LIMIT          = __Flx_REM_BARRETT_LIMIT;
 long Flx_SQR_QUARTSQRI_LIMIT        = __Flx_SQR_QUARTSQRI_LIMIT;
 long Flx_SQR_HALFSQRI_LIMIT         = __Flx_SQR_HALFSQRI_LIMIT;
@@ -45,6 +47,7 @@ long FpX_EXTGCD_LIMIT               = __FpX_EXTGCD_LIMIT;
 long FpX_GCD_LIMIT                  = __FpX_GCD_LIMIT;
 long FpX_HALFGCD_LIMIT              = __FpX_HALFGCD_LIMIT;
 long FpX_INVBARRETT_LIMIT           = __FpX_INVBARRETT_LIMIT;
+long FpX_MULTIEVAL_LIMIT            = __FpX_MULTIEVAL_LIMIT;
 long FpX_REM_BARRETT_LIMIT          = __FpX_REM_BARRETT_LIMIT;
 long FpXQX_BARRETT_LIMIT            = __FpXQX_BARRETT_LIMIT;
 long FpXQX_DIVREM_BARRETT_LIMIT     = __FpXQX_DIVREM_BARRETT_LIMIT;
@@ -52,6 +55,7 @@ long FpXQX_EXTGCD_LIMIT             = __FpXQX_EXTGCD_LIMIT;
 long FpXQX_GCD_LIMIT                = __FpXQX_GCD_LIMIT;
 long FpXQX_HALFGCD_LIMIT            = __FpXQX_HALFGCD_LIMIT;
 long FpXQX_INVBARRETT_LIMIT         = __FpXQX_INVBARRETT_LIMIT;
+long FpXQX_MULTIEVAL_LIMIT          = __FpXQX_MULTIEVAL_LIMIT;
 long FpXQX_REM_BARRETT_LIMIT        = __FpXQX_REM_BARRETT_LIMIT;
 long Fp_POW_BARRETT_LIMIT           = __Fp_POW_BARRETT_LIMIT;
 long Fp_POW_REDC_LIMIT              = __Fp_POW_REDC_LIMIT;
@@ -60,6 +64,7 @@ long INVNEWTON_LIMIT                = __INVNEWTON_LIMIT;
 long LOGAGMCX_LIMIT                 = __LOGAGMCX_LIMIT;
 long LOGAGM_LIMIT                   = __LOGAGM_LIMIT;
 long MULII_FFT_LIMIT                = __MULII_FFT_LIMIT;
+long MULII_FFT_PARALLEL_LIMIT       = __MULII_FFT_PARALLEL_LIMIT;
 long MULII_KARATSUBA_LIMIT          = __MULII_KARATSUBA_LIMIT;
 long MULRR_MULII_LIMIT              = __MULRR_MULII_LIMIT;
 long RgX_MUL_LIMIT                  = __RgX_MUL_LIMIT;
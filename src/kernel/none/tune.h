@@ -3,6 +3,7 @@
 #define __DIVRR_GMP_LIMIT                -1
 #define __EXPNEWTON_LIMIT                66
 #define __F2x_MUL_KARATSUBA_LIMIT        15
+#define __FROMDIGITS_PARALLEL_LIMIT      20000
 #define __Flx_BARRETT_HALFMULII_LIMIT    29
 #define __Flx_BARRETT_KARATSUBA_LIMIT    2561
 #define __Flx_BARRETT_MULII2_LIMIT       30
@@ -21,6 +22,7 @@
 #define __Flx_INVBARRETT_MULII2_LIMIT    36
 #define __Flx_INVBARRETT_MULII_LIMIT     3840
 #define __Flx_INVBARRETT_QUARTMULII_LIMIT 424
+#define __Flx_MULTIEVAL_LIMIT            39
 #define __Flx_MUL_HALFMULII_LIMIT        5
 #define __Flx_MUL_KARATSUBA_LIMIT        147
 #define __Flx_MUL_MULII2_LIMIT           5
@@ -45,6 +47,7 @@
 #define __FpXQX_GCD_LIMIT                254
 #define __FpXQX_HALFGCD_LIMIT            56
 #define __FpXQX_INVBARRETT_LIMIT         40
+#define __FpXQX_MULTIEVAL_LIMIT          10
 #define __FpXQX_REM_BARRETT_LIMIT        30
 #define __FpX_BARRETT_LIMIT              85
 #define __FpX_DIVREM_BARRETT_LIMIT       292
@@ -52,6 +55,7 @@
 #define __FpX_GCD_LIMIT                  731
 #define __FpX_HALFGCD_LIMIT              75
 #define __FpX_INVBARRETT_LIMIT           254
+#define __FpX_MULTIEVAL_LIMIT            16
 #define __FpX_REM_BARRETT_LIMIT          306
 #define __Fp_POW_BARRETT_LIMIT           101
 #define __Fp_POW_REDC_LIMIT              99
@@ -60,6 +64,7 @@
 #define __LOGAGMCX_LIMIT                 13
 #define __LOGAGM_LIMIT                   16
 #define __MULII_FFT_LIMIT                1441
+#define __MULII_FFT_PARALLEL_LIMIT       10000
 #define __MULII_KARATSUBA_LIMIT          23
 #define __MULRR_MULII_LIMIT              276
 #define __RgX_MUL_LIMIT                  9
@@ -71,6 +76,7 @@
 #define __DIVRR_GMP_LIMIT                -1
 #define __EXPNEWTON_LIMIT                66
 #define __F2x_MUL_KARATSUBA_LIMIT        23
+#define __FROMDIGITS_PARALLEL_LIMIT      40000
 #define __Flx_BARRETT_HALFMULII_LIMIT    244
 #define __Flx_BARRETT_KARATSUBA_LIMIT    905
 #define __Flx_BARRETT_MULII2_LIMIT       1004
@@ -89,6 +95,7 @@
 #define __Flx_INVBARRETT_MULII2_LIMIT    3672
 #define __Flx_INVBARRETT_MULII_LIMIT     4196
 #define __Flx_INVBARRETT_QUARTMULII_LIMIT 898
+#define __Flx_MULTIEVAL_LIMIT            45
 #define __Flx_MUL_HALFMULII_LIMIT        8
 #define __Flx_MUL_KARATSUBA_LIMIT        85
 #define __Flx_MUL_MULII2_LIMIT           3755
@@ -113,6 +120,7 @@
 #define __FpXQX_GCD_LIMIT                254
 #define __FpXQX_HALFGCD_LIMIT            48
 #define __FpXQX_INVBARRETT_LIMIT         40
+#define __FpXQX_MULTIEVAL_LIMIT          10
 #define __FpXQX_REM_BARRETT_LIMIT        30
 #define __FpX_BARRETT_LIMIT              144
 #define __FpX_DIVREM_BARRETT_LIMIT       306
@@ -120,6 +128,7 @@
 #define __FpX_GCD_LIMIT                  1292
 #define __FpX_HALFGCD_LIMIT              145
 #define __FpX_INVBARRETT_LIMIT           337
+#define __FpX_MULTIEVAL_LIMIT            18
 #define __FpX_REM_BARRETT_LIMIT          306
 #define __Fp_POW_BARRETT_LIMIT           97
 #define __Fp_POW_REDC_LIMIT              99
@@ -128,6 +137,7 @@
 #define __LOGAGMCX_LIMIT                 58
 #define __LOGAGM_LIMIT                   55
 #define __MULII_FFT_LIMIT                1386
+#define __MULII_FFT_PARALLEL_LIMIT       20000
 #define __MULII_KARATSUBA_LIMIT          18
 #define __MULRR_MULII_LIMIT              102
 #define __RgX_MUL_LIMIT                  5
@@ -997,10 +997,17 @@ varstate_restore(struct pari_varstate *s)
 void
 pari_thread_init_varstate(void)
 {
-  long i;
-  var_restore(&global_varstate);
   varpriority = (long*)newblock((MAXVARN+2)) + 1;
   varpriority[-1] = 1-LONG_MAX;
+  pari_thread_sync_varstate();
+}
+
+/* copy the state saved by pari_pthread_init_varstate to a running thread */
+void
+pari_thread_sync_varstate(void)
+{
+  long i;
+  var_restore(&global_varstate);
   for (i = 0; i < max_avail; i++) varpriority[i] = global_varpriority[i];
 }
 
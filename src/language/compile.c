@@ -189,6 +189,46 @@ compilestate_restore(struct pari_compilestate *comp)
   s_frame.n=comp->frames;
 }
 
+/* ep is one of the in-place operators _++, _+=_, ... */
+static int
+is_ptr_op(long ep, const char *code)
+{
+  const char *c = ((entree*)ep)->code;
+  return c && !strcmp(c, code);
+}
+
+/* Peephole pass: replace the first instruction of frequent sequences by a
+ * superinstruction. The remaining instructions of the sequence are kept in
+ * place and carry the operands, so that pc, dbg and frame information are
+ * unchanged; the evaluator skips them. */
+static void
+closure_peephole(char *s, GEN oper)
+{
+  long i, n = lg(oper)-1;
+  for (i = 1; i < n; i++)
+  {
+    op_code o = (op_code)s[i], o1 = (op_code)s[i+1];
+    if (o==OCpushlex && i+2 <= n && s[i+2]==OCcallgen2)
+    {
+      /* x OP y, x OP n */
+      if (o1==OCpushlex)       { s[i] = OCcallgen2lexlex; i += 2; }
+      else if (o1==OCpushstoi) { s[i] = OCcallgen2lexstoi; i += 2; }
+    }
+    else if (o==OCsimpleptrlex)
+    {
+      /* x++, x-- */
+      if (o1==OCcallgen && i+3 <= n && is_ptr_op(oper[i+1], "&")
+          && s[i+2]==OCpop && oper[i+2]==1 && s[i+3]==OCendptr && oper[i+3]==1)
+      { s[i] = OCcallptrlex; i += 3; }
+      /* x OP= y, x OP= n */
+      else if ((o1==OCpushlex || o1==OCpushstoi) && i+4 <= n
+          && s[i+2]==OCcallgen2 && is_ptr_op(oper[i+2], "&G")
+          && s[i+3]==OCpop && oper[i+3]==1 && s[i+4]==OCendptr && oper[i+4]==1)
+      { s[i] = o1==OCpushlex? OCcallptrlexlex: OCcallptrlexstoi; i += 4; }
+    }
+  }
+}
+
 static GEN
 getfunction(const struct codepos *pos, long arity, long nbmvar, GEN text, long gap)
 {
@@ -218,6 +258,7 @@ getfunction(const struct codepos *pos, long arity, long nbmvar, GEN text, long g
     if (dbg[i]<0) dbg[i]+=gap;
   }
   s[i]=0;
+  closure_peephole(s, gel(cl,3));
   s_opcode.n=pos->opcode;
   s_operand.n=pos->opcode;
   s_dbginfo.n=pos->opcode;
@@ -514,7 +514,7 @@ sd_histsize(const char *s, long flag)
     /* clean up */
     for ( ; v[g].z; g--)
     {
-      gunclone(v[g].z);
+      if (isclone(v[g].z)) gunclone(v[g].z);
       if (!g) g = sv;
     }
     pari_free((void*)v);
@@ -659,6 +659,18 @@ sd_primelimit(const char *v, long flag)
 { return sd_ulong(v,flag,"primelimit",&(GP_DATA->primelimit),
                   0,2*(ulong)(LONG_MAX-1024) + 1,NULL); }
 
+GEN
+sd_primetablefile(const char *v, long flag)
+{
+  GEN r = sd_string(v, flag, "primetablefile", &GP_DATA->primetablefile);
+  if (v && !*v)
+  {
+    free(GP_DATA->primetablefile);
+    GP_DATA->primetablefile = NULL;
+  }
+  return r;
+}
+
 GEN
 sd_simplify(const char *v, long flag)
 { return sd_toggle(v,flag,"simplify", &(GP_DATA->simplify)); }
@@ -959,5 +971,7 @@ default_gp_data(void)
   D->help = init_help();
   D->readline_state = DO_ARGS_COMPLETE;
   D->histfile = NULL;
+  D->stackfile = NULL;
+  D->primetablefile = NULL;
   return D;
 }
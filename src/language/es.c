@@ -32,6 +32,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
 #ifdef HAS_OPENDIR
 #include <dirent.h>
 #endif
+#ifdef HAS_MMAP
+#include <sys/mman.h>
+#endif
 
 #include "pari.h"
 #include "paripriv.h"
@@ -2946,13 +2949,14 @@ bruti_intern(GEN g, pariout_t *T, outString *S, int addsign)
         }
         str_puts(S, "])"); break;
       case t_LIST_MAP:
+      case t_LIST_HASHMAP:
         {
           pari_sp av;
           str_puts(S, "Map(");
           av = avma;
           bruti(maptomat_shallow(g),T,S);
           avma = av;
-          str_puts(S, ")"); break;
+          str_puts(S, list_typ(g) == t_LIST_MAP? ")": ", 1)"); break;
         }
       }
       break;
@@ -3225,6 +3229,7 @@ texi_sign(GEN g, pariout_t *T, outString *S, int addsign)
         }
         str_puts(S, "\\cr}\n"); break;
       case t_LIST_MAP:
+      case t_LIST_HASHMAP:
         {
           pari_sp av = avma;
           texi(maptomat_shallow(g),T,S);
@@ -3601,6 +3606,8 @@ pari_init_files(void)
   last_file=NULL;
 }
 
+static void binkey_close(void);
+
 void
 pari_thread_close_files(void)
 {
@@ -3608,6 +3615,7 @@ pari_thread_close_files(void)
   kill_file_stack(&last_file);
   if (last_filename) pari_free(last_filename);
   kill_file_stack(&last_tmp_file);
+  binkey_close();
 }
 
 void
@@ -4223,27 +4231,184 @@ _lfwrite(const void *a, size_t b, FILE *c) { _fwrite(a,sizeof(long),b,c); }
 static void
 _cfwrite(const void *a, size_t b, FILE *c) { _fwrite(a,sizeof(char),b,c); }
 
-enum { BIN_GEN, NAM_GEN, VAR_GEN, RELINK_TABLE };
+enum { BIN_GEN, NAM_GEN, VAR_GEN, RELINK_TABLE, BIN_MAP, NAM_MAP,
+       KEY_GEN, KEY_MAP, KEY_INDEX, KEY_TRAILER };
 
 static long
 rd_long(FILE *f) { long L; pari_fread_longs(&L, 1UL, f); return L; }
 static void
 wr_long(long L, FILE *f) { _lfwrite(&L, 1UL, f); }
 
-/* append x to file f */
 static void
-wrGEN(GEN x, FILE *f)
+wr_longs(void *f, GEN w, long n) { _lfwrite(w, n, (FILE*)f); }
+
+/* append x to file f, as copy_bin_canon(x): len, x, base, data */
+static void
+wrGEN(GEN x, FILE *f) { write_bin_canon(x, (void*)f, &wr_longs); }
+
+/* Mappable objects [BIN_MAP, NAM_MAP]: the data is stored in native form,
+ * relocated at a preferred address and aligned on a page boundary, so that
+ * it can be mapped in memory and used in place, without copy. The objects
+ * stay mapped until the end of the session and are never modified: GP
+ * variables only refer to them, and copy them before any modification.
+ * Reading the same object again reuses its mapping. */
+#define BINMAP_ALIGN 4096L
+#ifdef PARI_KERNEL_GMP
+#  define BINMAP_KERNEL 1L
+#else
+#  define BINMAP_KERNEL 0L
+#endif
+
+/* an object mapped from a binary file: the pages [a,b[ hold the data
+ * found at offset start in file (dev,ino) */
+typedef struct {
+  pari_sp a, b;
+  long start;
+#ifdef HAS_STAT
+  dev_t dev;
+  ino_t ino;
+#endif
+} binmap_t;
+
+/* shared by all threads, protected by mt_lock. Sorted by address; lo, hi
+ * bound all ranges, and only grow: they can be read without locking */
+static binmap_t *binmap;
+static long binmap_n;
+static pari_sp binmap_lo, binmap_hi;
+
+/* index of the range containing x, or -1 */
+static long
+binmap_search(pari_sp x)
 {
-  GENbin *p = copy_bin_canon(x);
-  size_t L = p->len;
+  long l = 0, u = binmap_n-1;
+  while (l <= u)
+  {
+    long m = (l+u) >> 1;
+    if (x < binmap[m].a) u = m-1;
+    else if (x >= binmap[m].b) l = m+1;
+    else return m;
+  }
+  return -1;
+}
 
-  wr_long(L,f);
-  if (L)
+/* is x inside an object mapped from a binary file ? */
+int
+isbinmapped(GEN x)
+{
+  pari_sp y = (pari_sp)x;
+  long i;
+  if (y < binmap_lo || y >= binmap_hi) return 0;
+  BLOCK_SIGINT_START
+  mt_lock(); i = binmap_search(y); mt_unlock();
+  BLOCK_SIGINT_END
+  return i >= 0;
+}
+
+#ifdef HAS_MMAP
+/* address of the pages mapping the data of size s at offset start in f,
+ * if they were mapped already */
+static pari_sp
+binmap_find(FILE *f, long start, size_t s)
+{
+  pari_sp a = 0;
+#ifdef HAS_STAT
+  struct stat st;
+  long i;
+  if (fstat(fileno(f), &st)) return 0;
+  BLOCK_SIGINT_START
+  mt_lock();
+  for (i = 0; i < binmap_n; i++)
   {
-    wr_long((long)p->x,f);
-    wr_long((long)p->base,f);
-    _lfwrite(GENbinbase(p), L,f);
+    binmap_t *m = binmap + i;
+    if (m->start == start && m->b - m->a == s
+        && m->dev == st.st_dev && m->ino == st.st_ino) { a = m->a; break; }
   }
+  mt_unlock();
+  BLOCK_SIGINT_END
+#else
+  (void)f; (void)start; (void)s;
+#endif
+  return a;
+}
+
+/* the inode of a mapped file stays in use even if the file is deleted, so
+ * (dev,ino) is not reused by another file; writebin only appends to files */
+static void
+binmap_add(FILE *f, long start, pari_sp a, pari_sp b)
+{
+  binmap_t *v;
+  long i;
+#ifdef HAS_STAT
+  struct stat st;
+  if (fstat(fileno(f), &st)) st.st_dev = st.st_ino = 0;
+#else
+  (void)f;
+#endif
+  BLOCK_SIGINT_START
+  mt_lock();
+  v = (binmap_t*)realloc((void*)binmap, (binmap_n+1)*sizeof(binmap_t));
+  if (v)
+  {
+    binmap = v;
+    for (i = binmap_n; i > 0 && v[i-1].a > a; i--) v[i] = v[i-1];
+    v[i].a = a; v[i].b = b; v[i].start = start;
+#ifdef HAS_STAT
+    v[i].dev = st.st_dev; v[i].ino = st.st_ino;
+#endif
+    if (!binmap_n++ || a < binmap_lo) binmap_lo = a;
+    if (b > binmap_hi) binmap_hi = b;
+  }
+  mt_unlock();
+  BLOCK_SIGINT_END
+  if (!v) pari_err(e_MEM);
+}
+#endif
+
+/* address at which the data of x should preferably be mapped: the pages
+ * are then shared with the page cache, without relocation */
+static pari_sp
+binmap_base(GEN x)
+{
+#if defined(LONG_IS_64BIT) && defined(HAS_MMAP)
+  return (pari_sp)0x100000000000UL + ((hash_GEN(x) & 0xfffUL) << 32);
+#else
+  (void)x; return 0; /* always relocate */
+#endif
+}
+
+/* as shiftaddress, when the data does not live at its new address yet */
+static void
+binmap_rebase(GEN x, long dec)
+{
+  long i, lx, tx = typ(x);
+  if (!is_recursive_t(tx) || (tx == t_LIST && !list_data(x))) return;
+  lx = lg(x);
+  for (i = lontyp[tx]; i < lx; i++)
+  {
+    GEN c = gel(x,i);
+    x[i] += dec; binmap_rebase(c, dec);
+  }
+}
+
+static void
+wrGENmap(GEN x, FILE *f)
+{
+  GENbin *p = copy_bin_flat(x);
+  size_t L = p->len;
+  pari_sp base = binmap_base(x);
+  long pos, pad;
+
+  binmap_rebase(p->x, (long)base - (long)p->base);
+  wr_long(L,f);
+  wr_long((long)base,f);
+  wr_long(p->x - p->base,f);
+  wr_long(BINMAP_KERNEL,f);
+  fflush(f); pos = ftell(f);
+  if (pos >= 0) pos += sizeof(long);
+  pad = pos < 0? 0: (BINMAP_ALIGN - pos % BINMAP_ALIGN) % BINMAP_ALIGN;
+  wr_long(pad,f);
+  for (; pad; pad--) fputc(0, f);
+  _lfwrite(GENbinbase(p), L,f);
   pari_free((void*)p);
 }
 
@@ -4266,18 +4431,18 @@ rdstr(FILE *f)
 }
 
 static void
-writeGEN(GEN x, FILE *f)
+writeGEN(GEN x, FILE *f, long flag)
 {
-  fputc(BIN_GEN,f);
-  wrGEN(x, f);
+  fputc(flag? BIN_MAP: BIN_GEN,f);
+  if (flag) wrGENmap(x, f); else wrGEN(x, f);
 }
 
 static void
-writenamedGEN(GEN x, const char *s, FILE *f)
+writenamedGEN(GEN x, const char *s, FILE *f, long flag)
 {
-  fputc(x ? NAM_GEN : VAR_GEN,f);
+  fputc(x ? (flag? NAM_MAP: NAM_GEN) : VAR_GEN,f);
   wrstr(s, f);
-  if (x) wrGEN(x, f);
+  if (x) { if (flag) wrGENmap(x, f); else wrGEN(x, f); }
 }
 
 /* read a GEN from file f */
@@ -4297,12 +4462,66 @@ rdGEN(FILE *f)
   return bin_copy(p);
 }
 
+/* read a mappable GEN from file f: map it in memory if possible, else copy
+ * it to the stack */
+static GEN
+rdGENmap(FILE *f)
+{
+  size_t L = (size_t)rd_long(f);
+  pari_sp base = (pari_sp)rd_long(f);
+  long off = rd_long(f), k = rd_long(f), pad = rd_long(f);
+  long start = ftell(f);
+  GENbin *p;
+
+  if (k != BINMAP_KERNEL)
+    pari_err(e_MISC,"binary file written with another multiprecision kernel");
+  if (start >= 0) start += pad;
+#ifdef HAS_MMAP
+  if (start >= 0 && start % sysconf(_SC_PAGESIZE) == 0)
+  {
+    size_t s = L*sizeof(long);
+    void *a = (void*)binmap_find(f, start, s);
+    if (!a)
+    {
+      a = mmap((void*)base, s, PROT_READ|PROT_WRITE, MAP_PRIVATE,
+               fileno(f), (off_t)start);
+      if (a != MAP_FAILED)
+      {
+        if ((pari_sp)a != base) shiftaddress((GEN)a + off, (long)a - (long)base);
+        binmap_add(f, start, (pari_sp)a, (pari_sp)a + s);
+      }
+    }
+    if (a != MAP_FAILED)
+    {
+      GEN x = (GEN)a + off;
+      if (fseek(f, start + s, SEEK_SET))
+        pari_err_FILE("input file [fseek]", "FILE*");
+      return x;
+    }
+  }
+#endif
+  for (; pad; pad--)
+    if (fgetc(f) == EOF) pari_err_FILE("input file [fread]", "FILE*");
+  p = (GENbin*)pari_malloc(sizeof(GENbin) + L*sizeof(long));
+  p->len  = L;
+  p->x    = (GEN)base + off;
+  p->base = (GEN)base;
+  p->rebase = &shiftaddress;
+  pari_fread_longs(GENbinbase(p), L,f);
+  return bin_copy(p);
+}
+
 /* read a binary object in file f. Set *ptc to the object "type":
  * BIN_GEN: an anonymous GEN x; return x.
  * NAM_GEN: a named GEN x, with name v; set 'v to x (changevalue) and return x
+ * BIN_MAP, NAM_MAP: as BIN_GEN, NAM_GEN, for a mappable GEN
  * VAR_GEN: a name v; create the (unassigned) variable v and return gnil
  * RELINK_TABLE: a relinking table for gen_relink(), to replace old adresses
  * in * the original session by new incarnations in the current session.
+ * KEY_GEN, KEY_MAP: as BIN_GEN, BIN_MAP, for a GEN stored under a key (see
+ * writebinkey); the key is skipped
+ * KEY_INDEX: an index block of a keyed binary file; return it
+ * KEY_TRAILER: the offset of the last index block; return gnil
  * H is the current relinking table
  * */
 static GEN
@@ -4313,17 +4532,19 @@ readobj(FILE *f, int *ptc, hashtable *H)
   switch(c)
   {
     case BIN_GEN:
-      x = rdGEN(f);
+    case BIN_MAP:
+      x = c == BIN_GEN? rdGEN(f): rdGENmap(f);
       if (H) gen_relink(x, H);
       break;
     case NAM_GEN:
+    case NAM_MAP:
     case VAR_GEN:
     {
       char *s = rdstr(f);
       if (!s) pari_err(e_MISC,"malformed binary file (no name)");
-      if (c == NAM_GEN)
+      if (c != VAR_GEN)
       {
-        x = rdGEN(f);
+        x = c == NAM_GEN? rdGEN(f): rdGENmap(f);
         if (H) gen_relink(x, H);
         err_printf("setting %s\n",s);
         changevalue(varentries[fetch_user_var(s)], x);
@@ -4336,7 +4557,19 @@ readobj(FILE *f, int *ptc, hashtable *H)
       break;
     }
     case RELINK_TABLE:
+    case KEY_INDEX:
       x = rdGEN(f); break;
+    case KEY_GEN:
+    case KEY_MAP:
+    {
+      pari_sp av = avma;
+      (void)rdGEN(f); avma = av; /* key */
+      x = c == KEY_GEN? rdGEN(f): rdGENmap(f);
+      if (H) gen_relink(x, H);
+      break;
+    }
+    case KEY_TRAILER:
+      (void)rd_long(f); x = gnil; break;
     case EOF: break;
     default: pari_err(e_MISC,"unknown code in readobj");
   }
@@ -4409,12 +4642,15 @@ file_is_binary(FILE *f)
 }
 
 void
-writebin(const char *name, GEN x)
+writebin0(const char *name, GEN x, long flag)
 {
-  FILE *f = fopen(name,"r");
+  FILE *f;
   pari_sp av = avma;
   GEN V;
-  int already = f? 1: 0;
+  int already;
+
+  if (flag < 0 || flag > 1) pari_err_FLAG("writebin");
+  f = fopen(name,"r"); already = f? 1: 0;
 
   if (f) {
     int ok = check_magic(name,f);
@@ -4431,7 +4667,7 @@ writebin(const char *name, GEN x)
     fputc(RELINK_TABLE,f);
     wrGEN(V, f);
   }
-  if (x) writeGEN(x,f);
+  if (x) writeGEN(x,f,flag);
   else
   {
     long v, maxv = pari_var_next();
@@ -4439,12 +4675,15 @@ writebin(const char *name, GEN x)
     {
       entree *ep = varentries[v];
       if (!ep) continue;
-      writenamedGEN((GEN)ep->value,ep->name,f);
+      writenamedGEN((GEN)ep->value,ep->name,f,flag);
     }
   }
   avma = av; fclose(f);
 }
 
+void
+writebin(const char *name, GEN x) { writebin0(name, x, 0); }
+
 /* read all objects in f. If f contains BIN_GEN that would be silently ignored
  * [i.e f contains more than one objet, not all of them 'named GENs'], return
  * them all in a vector and set 'vector'. */
@@ -4468,6 +4707,9 @@ readbin(const char *name, FILE *f, int *vector)
     switch(cy)
     {
       case BIN_GEN:
+      case BIN_MAP:
+      case KEY_GEN:
+      case KEY_MAP:
         pari_stack_pushp(&s_obj, (void*)y); break;
       case RELINK_TABLE:
         if (H) hash_destroy(H);
@@ -4484,13 +4726,439 @@ readbin(const char *name, FILE *f, int *vector)
       if (DEBUGLEVEL)
         pari_warn(warner,"%ld unnamed objects read. Returning then in a vector",
                   s_obj.n - 1);
-      x = gerepilecopy(av, obj);
+    { /* don't copy mapped objects */
+      long i, l = s_obj.n;
+      x = cgetg(l, t_VEC);
+      for (i = 1; i < l; i++)
+      {
+        GEN z = gel(obj,i);
+        gel(x,i) = isbinmapped(z)? z: gcopy(z);
+      }
+      x = gerepileupto(av, x);
       if (vector) *vector = 1;
+    }
   }
   pari_stack_delete(&s_obj);
   return x;
 }
 
+/* Keyed binary files. A sequence of entries, each of them a GEN x stored
+ * under a key k (a t_INT or a t_STR): [RELINK_TABLE] KEY_GEN k x, where x is
+ * written as for BIN_GEN (KEY_MAP: as for BIN_MAP). Each call to writebinkey
+ * appends its entries, then an index block KEY_INDEX [p, K, O] (K a vector
+ * of keys, O the t_VECSMALL of the file offsets of the corresponding
+ * entries, p the offset of the previous index block or 0), then a trailer
+ * KEY_TRAILER b (b the offset of the new block); the trailer closes the file.
+ * The file is never modified in place. A new index block absorbs the previous
+ * ones as long as they are not larger than itself, so that there are
+ * O(log n) blocks for n keys and the total size of the blocks written is
+ * O(n log n). The index of a file is loaded once in a hash map, and updated
+ * when the file grows: accessing an entry costs a single seek. If the file
+ * was replaced in the meantime, the index is loaded anew. */
+typedef struct {
+  char *name; /* file name */
+  long size; /* file size when the index was loaded */
+  long last; /* offset of the last index block loaded */
+  ulong tail; /* hash of the last bytes of the file when it was loaded */
+#ifdef HAS_STAT
+  dev_t dev; ino_t ino; /* identity of the file */
+#endif
+  GEN M; /* t_LIST_HASHMAP: key -> offset */
+} binkey_t;
+static THREAD binkey_t *binkey;
+static THREAD long binkey_n;
+
+static long
+binkey_hdrsize(void) { return strlen(MAGIC) + 1 + 2*sizeof(long); }
+
+static long
+file_size(FILE *f)
+{
+  long s = fseek(f, 0, SEEK_END)? -1: ftell(f);
+  if (s < 0) pari_err_FILE("input file [fseek]", "FILE*");
+  return s;
+}
+
+static void
+file_seek(FILE *f, long off)
+{ if (fseek(f, off, SEEK_SET)) pari_err_FILE("input file [fseek]", "FILE*"); }
+
+static void
+check_binkey(const char *fun, GEN k)
+{ if (typ(k) != t_INT && typ(k) != t_STR) pari_err_TYPE(fun, k); }
+
+/* offset of the last index block of file f of size s, 0 if there is none */
+static long
+binkey_last(const char *name, FILE *f, long s)
+{
+  long h = binkey_hdrsize();
+  if (s == h) return 0;
+  if (s > h + (long)sizeof(long))
+  {
+    file_seek(f, s - 1 - sizeof(long));
+    if (fgetc(f) == KEY_TRAILER) return rd_long(f);
+  }
+  pari_err(e_MISC, "%s is not a keyed binary file", name);
+  return 0; /*LCOV_EXCL_LINE*/
+}
+
+/* index block at offset off */
+static GEN
+binkey_block(FILE *f, long off)
+{
+  GEN B;
+  file_seek(f, off);
+  if (fgetc(f) != KEY_INDEX) pari_err(e_MISC,"malformed keyed binary file");
+  B = rdGEN(f);
+  if (typ(B) != t_VEC || lg(B) != 4)
+    pari_err(e_MISC,"malformed keyed binary file");
+  return B;
+}
+
+static void
+binkey_kill(binkey_t *c)
+{ listkill(c->M); c->size = c->last = 0; }
+
+/* djb hash of the last (at most 256) bytes of the first s bytes of f */
+static ulong
+binkey_tail(FILE *f, long s)
+{
+  long n = minss(s, 256);
+  ulong h = 5381;
+  file_seek(f, s - n);
+  while (n--) h = ((h << 5) + h) + (ulong)fgetc(f);
+  return h;
+}
+
+/* is the index c, loaded from a file of size c->size, still valid for f, of
+ * size s ? Since keyed binary files are only appended to, the end of the
+ * file indexed by c must still be in place. */
+static int
+binkey_valid(binkey_t *c, FILE *f, long s)
+{
+#ifdef HAS_STAT
+  struct stat st;
+  if (fstat(fileno(f), &st) || st.st_dev != c->dev || st.st_ino != c->ino)
+    return 0;
+#endif
+  return s >= c->size && binkey_tail(f, c->size) == c->tail;
+}
+
+static void
+binkey_stamp(binkey_t *c, FILE *f)
+{
+#ifdef HAS_STAT
+  struct stat st;
+  if (fstat(fileno(f), &st)) { c->dev = 0; c->ino = 0; }
+  else { c->dev = st.st_dev; c->ino = st.st_ino; }
+#endif
+  c->tail = binkey_tail(f, c->size);
+}
+
+/* forget the index of file name, which is about to change */
+static void
+binkey_forget(const char *name)
+{
+  long i;
+  for (i = 0; i < binkey_n; i++)
+    if (!strcmp(binkey[i].name, name)) binkey_kill(binkey + i);
+}
+
+static void
+binkey_close(void)
+{
+  long i;
+  for (i = 0; i < binkey_n; i++)
+  {
+    binkey_kill(binkey + i);
+    pari_free((void*)binkey[i].M); pari_free((void*)binkey[i].name);
+  }
+  if (binkey) pari_free((void*)binkey);
+  binkey = NULL; binkey_n = 0;
+}
+
+/* the index of the keyed binary file name, f an open stream on it */
+static GEN
+binkey_index(const char *name, FILE *f)
+{
+  pari_sp av = avma;
+  long i, j, s = file_size(f), off, last;
+  binkey_t *c = NULL;
+  GEN B;
+
+  for (i = 0; i < binkey_n; i++)
+    if (!strcmp(binkey[i].name, name)) { c = binkey + i; break; }
+  if (!c)
+  {
+    binkey = (binkey_t*)pari_realloc((void*)binkey,
+                                     (binkey_n+1)*sizeof(binkey_t));
+    c = binkey + binkey_n++;
+    c->name = pari_strdup(name);
+    c->size = c->last = 0;
+    c->M = (GEN)pari_malloc(3*sizeof(long));
+    c->M[0] = evaltyp(t_LIST)|evallg(3);
+    c->M[1] = evaltyp(t_LIST_HASHMAP);
+    list_data(c->M) = NULL;
+  }
+  if (c->size && !binkey_valid(c, f, s)) binkey_kill(c); /* file replaced */
+  if (s == c->size) return c->M;
+  last = off = binkey_last(name, f, s);
+  /* blocks which were not loaded yet, newest first */
+  B = cgetg(1, t_VEC);
+  while (off > c->last)
+  {
+    GEN b = binkey_block(f, off);
+    B = vec_append(B, b); off = itos(gel(b,1));
+  }
+  for (i = lg(B)-1; i > 0; i--)
+  {
+    GEN K = gmael(B,i,2), O = gmael(B,i,3);
+    for (j = 1; j < lg(K); j++) mapput(c->M, gel(K,j), stoi(O[j]));
+  }
+  c->size = s; c->last = last; binkey_stamp(c, f);
+  avma = av; return c->M;
+}
+
+/* read the entry at offset off */
+static GEN
+binkey_entry(FILE *f, long off)
+{
+  hashtable *H = NULL;
+  GEN x;
+  int c;
+  file_seek(f, off);
+  for(;;)
+  {
+    x = readobj(f, &c, H);
+    if (c == KEY_GEN || c == KEY_MAP) break;
+    if (c != RELINK_TABLE) pari_err(e_MISC,"malformed keyed binary file");
+    H = hash_from_link(gel(x,1),gel(x,2), 0);
+  }
+  if (H) hash_destroy(H);
+  return x;
+}
+
+/* keys K[i] and offsets O[i], later entries taking precedence: remove
+ * overridden entries, sort by key */
+static GEN
+binkey_merge(GEN K, GEN O)
+{
+  long i, j, l = lg(K);
+  GEN P = cgetg(l, t_VEC), K2 = cgetg(l, t_VEC), O2 = cgetg(l, t_VECSMALL);
+  for (i = 1; i < l; i++) gel(P,i) = mkvec2(gel(K,i), stoi(i));
+  P = gen_sort(P, (void*)&cmp_universal, &cmp_nodata);
+  for (i = j = 1; i < l; i++)
+    if (i == l-1 || !gidentical(gmael(P,i,1), gmael(P,i+1,1)))
+    {
+      long k = itos(gmael(P,i,2));
+      gel(K2,j) = gel(K,k); O2[j++] = O[k];
+    }
+  setlg(K2, j); setlg(O2, j); return mkvec2(K2, O2);
+}
+
+/* append the objects X[i] under the keys K[i] to the keyed binary file name;
+ * if K is not a t_VEC, append X under the key K */
+void
+writebinkey(const char *name, GEN K, GEN X, long flag)
+{
+  pari_sp av = avma;
+  pariFILE *pf;
+  FILE *f;
+  long i, n, l, prev = 0;
+  GEN O, KB, OB;
+
+  if (flag < 0 || flag > 1) pari_err_FLAG("writebinkey");
+  if (typ(K) != t_VEC) { K = mkvec(K); X = mkvec(X); }
+  else if (typ(X) != t_VEC || lg(X) != lg(K)) pari_err_DIM("writebinkey");
+  l = lg(K); n = l-1;
+  for (i = 1; i < l; i++) check_binkey("writebinkey", gel(K,i));
+  KB = cgetg(1, t_VEC); OB = cgetg(1, t_VECSMALL);
+  pf = pari_fopen(name,"r");
+  if (pf)
+  {
+    f = pf->file;
+    if (!check_magic(name,f)) pari_err_FILE("binary output file",name);
+    prev = binkey_last(name, f, file_size(f));
+    while (prev)
+    { /* absorb the previous blocks which are not larger than the new one */
+      GEN b = binkey_block(f, prev), k = gel(b,2);
+      if (lg(k)-1 > n + lg(KB)-1) break;
+      KB = shallowconcat(k, KB);
+      OB = vecsmall_concat(gel(b,3), OB); prev = itos(gel(b,1));
+    }
+    pari_fclose(pf);
+    f = (pf = pari_fopen_or_fail(name,"a"))->file;
+  }
+  else
+  {
+    f = (pf = pari_fopen_or_fail(name,"a"))->file;
+    write_magic(f);
+  }
+  O = cgetg(l, t_VECSMALL);
+  for (i = 1; i < l; i++)
+  {
+    GEN x = gel(X,i), V = copybin_unlink(x);
+    fflush(f); O[i] = ftell(f);
+    if (lg(gel(V,1)) > 1) { fputc(RELINK_TABLE,f); wrGEN(V, f); }
+    fputc(flag? KEY_MAP: KEY_GEN, f);
+    wrGEN(gel(K,i), f);
+    if (flag) wrGENmap(x, f); else wrGEN(x, f);
+  }
+  O = binkey_merge(shallowconcat(KB, K), vecsmall_concat(OB, O));
+  fflush(f); i = ftell(f);
+  fputc(KEY_INDEX, f);
+  wrGEN(mkvec3(stoi(prev), gel(O,1), gel(O,2)), f);
+  fputc(KEY_TRAILER, f); wr_long(i, f);
+  avma = av; pari_fclose(pf);
+  binkey_forget(name);
+}
+
+/* remove the binary file name, if it exists; refuse to remove any other
+ * file */
+void
+binfile_unlink(const char *name)
+{
+  pariFILE *pf = pari_fopen(name, "r");
+  if (!pf) return;
+  if (!check_magic(name,pf->file)) pari_err_FILE("binary output file",name);
+  pari_fclose(pf);
+  pari_unlink(name);
+  binkey_forget(name);
+}
+
+static pariFILE *
+binkey_open(const char *name)
+{
+  pariFILE *pf = pari_fopen_or_fail(name, "r");
+  if (!check_magic(name,pf->file)) pari_err_FILE("input file",name);
+  return pf;
+}
+
+static char *
+binkey_name(const char *name)
+{
+  char *t = path_expand(name), *s = stack_strdup(t);
+  pari_free(t); return s;
+}
+
+/* the object stored under the key k in the keyed binary file name */
+GEN
+readbinkey(const char *name, GEN k)
+{
+  pari_sp av = avma;
+  char *s = binkey_name(name);
+  pariFILE *pf = binkey_open(s);
+  GEN z, x;
+
+  check_binkey("readbinkey", k);
+  if (!mapisdefined(binkey_index(s, pf->file), k, &z))
+    pari_err_COMPONENT("readbinkey", "not in", strtoGENstr(s), k);
+  x = binkey_entry(pf->file, itos(z));
+  pari_fclose(pf);
+  return gerepileupto(av, x);
+}
+
+/* as readbinkey, but return NULL if the file name does not exist, or has no
+ * entry under the key k */
+GEN
+readbinkey_i(const char *name, GEN k)
+{
+  pari_sp av = avma;
+  pariFILE *pf = pari_fopen(name, "r");
+  GEN z, x = NULL;
+  if (!pf) return NULL;
+  if (check_magic(name, pf->file)
+      && mapisdefined(binkey_index(name, pf->file), k, &z))
+    x = binkey_entry(pf->file, itos(z));
+  pari_fclose(pf);
+  return x? gerepileupto(av, x): NULL;
+}
+
+/* the sorted vector of keys of the keyed binary file name */
+GEN
+readbinkeys(const char *name)
+{
+  pari_sp av = avma;
+  char *s = binkey_name(name);
+  pariFILE *pf = binkey_open(s);
+  GEN x = mapdomain(binkey_index(s, pf->file));
+  pari_fclose(pf); return gerepileupto(av, x);
+}
+
+/* call(E, x) for each x in the file name, until it returns a non-zero value:
+ * x runs through the values of the expressions in the file (flag = 0), or
+ * its lines (flag = 1); through the objects of a binary file (flag = 0).
+ * Each x is discarded before reading the next one. */
+void
+forfile(void *E, long call(void*, GEN), const char *name, long flag)
+{
+  pari_sp av = avma;
+  FILE *f;
+
+  if (flag < 0 || flag > 1) pari_err_FLAG("forfile");
+  f = switchin(name);
+  if (file_is_binary(f))
+  {
+    hashtable *H = NULL;
+    GEN x;
+    int c;
+    if (flag) pari_err(e_MISC,"forfile: %s is a binary file",name);
+    if (!check_magic(name,f)) pari_err_FILE("input file",name);
+    while ((x = readobj(f, &c, H)))
+    {
+      switch(c)
+      {
+        case RELINK_TABLE:
+          if (H) hash_destroy(H);
+          H = hash_from_link(gel(x,1),gel(x,2), 0); /* fall through */
+        case VAR_GEN: case KEY_INDEX: case KEY_TRAILER:
+          x = NULL;
+      }
+      if (x && call(E, x)) break;
+      avma = av;
+    }
+    if (H) hash_destroy(H);
+  }
+  else
+  {
+    Buffer *b = new_buffer();
+    input_method IM;
+    IM.fgets = (fgets_t)&fgets;
+    IM.file = (void*)f;
+    for(;;)
+    {
+      GEN x;
+      if (flag)
+      {
+        char *s = b->buf, *e;
+        if (!file_getline(b, &s, &IM)) break;
+        e = s + strlen(s)-1;
+        if (*e == '\n') *e = 0;
+        x = strtoGENstr(s);
+      }
+      else
+      {
+        if (!gp_read_stream_buf(f, b)) break;
+        if (!*(b->buf)) continue;
+        x = readseq(b->buf);
+      }
+      if (call(E, x)) break;
+      avma = av;
+    }
+    delete_buffer(b);
+  }
+  popinfile(); avma = av;
+}
+
+void
+forfile0(GEN name, GEN code, long flag)
+{
+  if (typ(name) != t_STR) pari_err_TYPE("forfile", name);
+  push_lex(gen_0, code);
+  forfile((void*)code, &gp_evalvoid, GSTR(name), flag);
+  pop_lex(1);
+}
+
 /*******************************************************************/
 /**                                                               **/
 /**                             GP I/O                            **/
@@ -4666,7 +5334,7 @@ error0(GEN g)
 
 void warning0(GEN g) { pari_warn(warnuser, g); }
 
-static char *
+char *
 wr_check(const char *s) {
   char *t = path_expand(s);
   if (GP_DATA->secure)
@@ -4693,7 +5361,12 @@ wr(const char *s, GEN g, long flag, int addnl)
 void write0  (const char *s, GEN g) { wr(s, g, f_RAW, 1); }
 void writetex(const char *s, GEN g) { wr(s, g, f_TEX, 1); }
 void write1  (const char *s, GEN g) { wr(s, g, f_RAW, 0); }
-void gpwritebin(const char *s, GEN x) { char *t=wr_check(s); writebin(t, x); pari_free(t);}
+void
+gpwritebin(const char *s, GEN x, long flag)
+{ char *t = wr_check(s); writebin0(t, x, flag); pari_free(t); }
+void
+gpwritebinkey(const char *s, GEN K, GEN X, long flag)
+{ char *t = wr_check(s); writebinkey(t, K, X, flag); pari_free(t); }
 
 /*******************************************************************/
 /**                                                               **/
@@ -4736,9 +5409,9 @@ pari_add_hist(GEN x, long time)
   gp_hist *H = GP_DATA->hist;
   ulong i = H->total % H->size;
   H->total++;
-  if (H->v[i].z) gunclone(H->v[i].z);
+  if (H->v[i].z && isclone(H->v[i].z)) gunclone(H->v[i].z);
   H->v[i].t = time;
-  H->v[i].z = gclone(x);
+  H->v[i].z = isbinmapped(x)? x: gclone(x);
 }
 
 ulong
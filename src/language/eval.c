@@ -191,12 +191,15 @@ void
 changevalue(entree *ep, GEN x)
 {
   var_cell *v = (var_cell*) ep->pvalue;
-  if (v == INITIAL) new_val_cell(ep, x, COPY_VAL);
+  /* objects mapped by readbin are shared, copied on modification */
+  char flag = isbinmapped(x)? PUSH_VAL: COPY_VAL;
+  if (v == INITIAL) new_val_cell(ep, x, flag);
   else
   {
     GEN old_val = (GEN) ep->value; /* beware: gunclone_deep may destroy old x */
-    ep->value = (void *) gclone(x);
-    if (v->flag == COPY_VAL) gunclone_deep(old_val); else v->flag = COPY_VAL;
+    ep->value = (void *) (flag == COPY_VAL? gclone(x): x);
+    if (v->flag == COPY_VAL) gunclone_deep(old_val);
+    v->flag = flag;
   }
 }
 
@@ -390,15 +393,55 @@ static THREAD struct var_lex *var;
 static THREAD struct trace *trace;
 static THREAD pari_stack s_st, s_ptrs, s_var, s_lvars, s_trace, s_prec;
 
+/* v owns its value, which is a t_INT nobody else refers to */
+INLINE int
+lex_ownint(struct var_lex *v)
+{
+  GEN x = v->value;
+  return v->flag == COPY_VAL && typ(x) == t_INT && bl_refc(x) == 1;
+}
+
 static void
 changelex(long vn, GEN x)
 {
   struct var_lex *v=var+s_var.n+vn;
   GEN old_val = v->value;
+  /* integer loop variables: reuse the clone instead of free + malloc */
+  if (typ(x) == t_INT && lex_ownint(v) && lgefint(x) <= lg(old_val))
+  { affii(x, old_val); return; }
+  if (isbinmapped(x))
+  { /* shared, copied on modification */
+    v->value = x;
+    if (v->flag == COPY_VAL) gunclone_deep(old_val);
+    v->flag = PUSH_VAL; return;
+  }
   v->value = gclone(x);
   if (v->flag == COPY_VAL) gunclone_deep(old_val); else v->flag = COPY_VAL;
 }
 
+/* x += n in place, x a lexical variable holding a small t_INT. Return 0 if
+ * this is not possible (the caller then uses the generic code) */
+static int
+lex_addsi(long vn, long n)
+{
+  struct var_lex *v = var+s_var.n+vn;
+  GEN x = v->value;
+  long a, z;
+  if (!lex_ownint(v) || lg(x) < 3 || is_bigint(x)) return 0;
+  a = itos(x); z = (long)((ulong)a + (ulong)n);
+  if (((a^z) & (n^z)) < 0) return 0; /* overflow */
+  affsi(z, x); return 1;
+}
+
+/* x OP= y, y a small t_INT */
+INLINE int
+lex_opeqsi(long vn, void *f, long n)
+{
+  if (f == (void*)gadde) return lex_addsi(vn, n);
+  if (f == (void*)gsube) return n != (long)HIGHBIT && lex_addsi(vn, -n);
+  return 0;
+}
+
 INLINE GEN
 copylex(long vn)
 {
@@ -958,10 +1001,16 @@ closure_eval(GEN C)
         gp_pointer *g = &ptrs[--rp];
         if (g->ep)
         {
-          if (g->vn)
-            changelex(g->vn, g->x);
-          else
+          if (!g->vn)
             changevalue(g->ep, g->x);
+          else if (g->ox == var[s_var.n+g->vn].value)
+          { /* still referenced by the variable: unlock first, so that
+             * changelex can reuse it */
+            clone_unlock(g->ox);
+            changelex(g->vn, g->x); continue;
+          }
+          else
+            changelex(g->vn, g->x);
         }
         else change_compo(&(g->c), g->x);
         clone_unlock(g->ox);
@@ -1290,6 +1339,60 @@ closure_eval(GEN C)
         gel(st,sp++)=res;
         break;
       }
+    /* superinstructions: the following instructions of the sequence only
+     * carry the operands and are skipped. trace[t].pc is set to the call so
+     * that errors are reported as for the plain sequence. */
+    case OCcallgen2lexlex: /* pushlex, pushlex, callgen2 */
+    case OCcallgen2lexstoi: /* pushlex, pushstoi, callgen2 */
+      {
+        entree *ep = (entree *)oper[pc+2];
+        GEN x = var[s_var.n+operand].value, y, res;
+        long o = oper[pc+1];
+        y = opcode==OCcallgen2lexlex? var[s_var.n+o].value: stoi(o);
+        trace[t].pc = pc += 2;
+        res = ((GEN (*)(GEN,GEN))ep->value)(x, y);
+        if (br_status) goto endeval;
+        gel(st,sp++)=res;
+        break;
+      }
+    case OCcallptrlex: /* simpleptrlex, callgen, pop, endptr */
+      {
+        entree *ep = (entree *)oper[pc+1];
+        GEN x;
+        if ((ep->value == (void*)gadd1e && lex_addsi(operand, 1))
+         || (ep->value == (void*)gsub1e && lex_addsi(operand, -1)))
+        { pc += 3; break; }
+        x = var[s_var.n+operand].value;
+        trace[t].pc = pc+1;
+        (void)((GEN (*)(GEN*))ep->value)(&x);
+        pc += 3;
+        changelex(operand, x);
+        break;
+      }
+    case OCcallptrlexlex: /* simpleptrlex, pushlex, callgen2, pop, endptr */
+    case OCcallptrlexstoi: /* simpleptrlex, pushstoi, callgen2, pop, endptr */
+      {
+        entree *ep = (entree *)oper[pc+2];
+        GEN x, y;
+        long o = oper[pc+1];
+        if (opcode==OCcallptrlexlex)
+        {
+          y = var[s_var.n+o].value;
+          if (typ(y)==t_INT && !is_bigint(y)
+              && lex_opeqsi(operand, ep->value, itos(y))) { pc += 4; break; }
+        }
+        else
+        {
+          if (lex_opeqsi(operand, ep->value, o)) { pc += 4; break; }
+          y = stoi(o);
+        }
+        x = var[s_var.n+operand].value;
+        trace[t].pc = pc+2;
+        (void)((GEN (*)(GEN*,GEN))ep->value)(&x, y);
+        pc += 4;
+        changelex(operand, x);
+        break;
+      }
     case OCcalllong:
       {
         entree *ep = (entree *)operand;
@@ -1613,6 +1716,7 @@ pareval(GEN C)
   worker = snm_closure(is_entry("_pareval_worker"), NULL);
   V = cgetg(l, t_VEC);
   mt_queue_start(&pt, worker);
+  C = mt_queue_share(&pt, C);
   for (i=1; i<l || pending; i++)
   {
     mt_queue_submit(&pt, i, i<l? mkvec(gel(C,i)): NULL);
@@ -1630,9 +1734,13 @@ parvector_worker(GEN i, GEN C)
 }
 
 GEN
-parfor_worker(GEN i, GEN C)
+parfor_worker(GEN V, GEN C)
 {
-  retmkvec2(gcopy(i), closure_callgen1(C, i));
+  pari_sp av = avma;
+  long i, l = lg(V);
+  GEN W = cgetg(l, t_VEC);
+  for (i = 1; i < l; i++) gel(W,i) = closure_callgen1(C, gel(V,i));
+  return gerepilecopy(av, mkvec2(V, W));
 }
 
 GEN
@@ -1690,6 +1798,63 @@ parsum(GEN a, GEN b, GEN code, GEN x)
   return gerepilecopy(av, x);
 }
 
+/* parfor and its variants group consecutive arguments in a single task.
+ * The size of the chunks is doubled while the tasks are too short to
+ * amortize the cost of the queue, and halved when they get long enough to
+ * hurt load balancing. */
+#define PARFOR_CHUNK_MS  10 /* target duration of a task */
+#define PARFOR_CHUNK_MAX 1024
+
+struct parfor_chunk
+{
+  long n; /* size of the next chunk */
+  long done; /* number of tasks completed since T was started */
+  pari_timer T;
+};
+
+static void
+parfor_chunk_init(struct parfor_chunk *C)
+{
+  C->n = 1; C->done = 0; walltimer_start(&C->T);
+}
+
+/* a task has completed; once the threads have completed one task each,
+ * estimate the duration of a task and adjust the chunk size */
+static void
+parfor_chunk_update(struct parfor_chunk *C)
+{
+  long t, nbt = maxss(pari_mt_nbthreads, 1);
+  if (++C->done < nbt) return;
+  t = walltimer_delay(&C->T) * nbt;
+  if (t < C->done * (PARFOR_CHUNK_MS/2))
+  { if (C->n < PARFOR_CHUNK_MAX) C->n <<= 1; }
+  else if (t > C->done * (2*PARFOR_CHUNK_MS) && C->n > 1)
+    C->n >>= 1;
+  C->done = 0;
+}
+
+/* done = [V, W] output by parfor_worker: run call(E, V[i], W[i]) in order
+ * for the V[i] < stop (cmp), until it requests a break. Return the new
+ * value of stop, copied at av */
+static GEN
+parfor_end(GEN done, GEN stop, int cmp(GEN, GEN), long *status,
+           void *E, long call(void*, GEN, GEN), pari_sp av)
+{
+  GEN V = gel(done,1), W = gel(done,2);
+  long i, l = lg(V);
+  for (i = 1; i < l; i++)
+  {
+    if (stop && cmp(gel(V,i), stop) >= 0) break;
+    if (call(E, gel(V,i), gel(W,i)))
+    {
+      *status = br_status;
+      br_status = br_NONE;
+      return gerepilecopy(av, gel(V,i));
+    }
+  }
+  return stop;
+}
+
 void
 parfor(GEN a, GEN b, GEN code, void *E, long call(void*, GEN, GEN))
 {
@@ -1697,8 +1862,9 @@ parfor(GEN a, GEN b, GEN code, void *E, long call(void*, GEN, GEN))
   long running, pending = 0;
   long status = br_NONE;
   GEN worker = snm_closure(is_entry("_parfor_worker"), mkvec(code));
-  GEN done, stop = NULL;
+  GEN v, done, stop = NULL;
   struct pari_mt pt;
+  struct parfor_chunk C;
   if (typ(a) != t_INT) pari_err_TYPE("parfor",a);
   if (b)
   {
@@ -1712,20 +1878,27 @@ parfor(GEN a, GEN b, GEN code, void *E, long call(void*, GEN, GEN))
       b = gfloor(b);
   }
   mt_queue_start(&pt, worker);
-  a = mkvec(setloop(a));
+  a = setloop(a);
+  parfor_chunk_init(&C);
   av2 = avma;
-  while ((running = (!stop && (!b || cmpii(gel(a,1),b) <= 0))) || pending)
+  while ((running = (!stop && (!b || cmpii(a,b) <= 0))) || pending)
   {
-    mt_queue_submit(&pt, 0, running ? a: NULL);
+    v = NULL;
+    if (running)
+    {
+      long i;
+      v = cgetg(C.n+1, t_VEC);
+      for (i = 1; i <= C.n && (!b || cmpii(a,b) <= 0); i++, a = incloop(a))
+        gel(v,i) = icopy(a);
+      setlg(v, i); v = mkvec(v);
+    }
+    mt_queue_submit(&pt, 0, v);
     done = mt_queue_get(&pt, NULL, &pending);
-    if (call && done && (!stop || cmpii(gel(done,1),stop) < 0))
-      if (call(E, gel(done,1), gel(done,2)))
-      {
-        status = br_status;
-        br_status = br_NONE;
-        stop = gerepileuptoint(av2, gel(done,1));
-      }
-    gel(a,1) = incloop(gel(a,1));
+    if (done)
+    {
+      parfor_chunk_update(&C);
+      if (call) stop = parfor_end(done, stop, cmpii, &status, E, call, av2);
+    }
     if (!stop) avma = av2;
   }
   avma = av2;
@@ -1758,26 +1931,34 @@ parforprime(GEN a, GEN b, GEN code, void *E, long call(void*, GEN, GEN))
   long running, pending = 0;
   long status = br_NONE;
   GEN worker = snm_closure(is_entry("_parfor_worker"), mkvec(code));
-  GEN v, done, stop = NULL;
+  GEN p, v, done, stop = NULL;
   struct pari_mt pt;
+  struct parfor_chunk C;
   forprime_t T;
 
   if (!forprime_init(&T, a,b)) { avma = av; return; }
   mt_queue_start(&pt, worker);
-  v = mkvec(gen_0);
+  parfor_chunk_init(&C);
   av2 = avma;
-  while ((running = (!stop && forprime_next(&T))) || pending)
+  p = forprime_next(&T);
+  while ((running = (!stop && p)) || pending)
   {
-    gel(v, 1) = T.pp;
-    mt_queue_submit(&pt, 0, running ? v: NULL);
+    v = NULL;
+    if (running)
+    {
+      long i;
+      v = cgetg(C.n+1, t_VEC);
+      for (i = 1; i <= C.n && p; i++, p = forprime_next(&T))
+        gel(v,i) = icopy(p);
+      setlg(v, i); v = mkvec(v);
+    }
+    mt_queue_submit(&pt, 0, v);
     done = mt_queue_get(&pt, NULL, &pending);
-    if (call && done && (!stop || cmpii(gel(done,1),stop) < 0))
-      if (call(E, gel(done,1), gel(done,2)))
-      {
-        status = br_status;
-        br_status = br_NONE;
-        stop = gerepileuptoint(av2, gel(done,1));
-      }
+    if (done)
+    {
+      parfor_chunk_update(&C);
+      if (call) stop = parfor_end(done, stop, cmpii, &status, E, call, av2);
+    }
     if (!stop) avma = av2;
   }
   avma = av2;
@@ -1801,25 +1982,33 @@ parforvec(GEN x, GEN code, long flag, void *E, long call(void*, GEN, GEN))
   GEN worker = snm_closure(is_entry("_parfor_worker"), mkvec(code));
   GEN done, stop = NULL;
   struct pari_mt pt;
+  struct parfor_chunk C;
   forvec_t T;
-  GEN a, v = gen_0;
+  GEN a, v;
 
   if (!forvec_init(&T, x, flag)) { avma = av; return; }
   mt_queue_start(&pt, worker);
-  a = mkvec(gen_0);
+  parfor_chunk_init(&C);
   av2 = avma;
-  while ((running = (!stop && v && (v = forvec_next(&T)))) || pending)
+  v = forvec_next(&T);
+  while ((running = (!stop && v)) || pending)
   {
-    gel(a, 1) = v;
-    mt_queue_submit(&pt, 0, running ? a: NULL);
+    a = NULL;
+    if (running)
+    {
+      long i;
+      a = cgetg(C.n+1, t_VEC);
+      for (i = 1; i <= C.n && v; i++, v = forvec_next(&T))
+        gel(a,i) = gcopy(v);
+      setlg(a, i); a = mkvec(a);
+    }
+    mt_queue_submit(&pt, 0, a);
     done = mt_queue_get(&pt, NULL, &pending);
-    if (call && done && (!stop || lexcmp(gel(done,1),stop) < 0))
-      if (call(E, gel(done,1), gel(done,2)))
-      {
-        status = br_status;
-        br_status = br_NONE;
-        stop = gerepilecopy(av2, gel(done,1));
-      }
+    if (done)
+    {
+      parfor_chunk_update(&C);
+      if (call) stop = parfor_end(done, stop, lexcmp, &status, E, call, av2);
+    }
     if (!stop) avma = av2;
   }
   avma = av2;
@@ -2098,6 +2287,21 @@ closure_disassemble(GEN C)
     case OCendptr:
       pari_printf("endptr\t\t%ld\n",operand);
       break;
+    case OCcallgen2lexlex:
+      pari_printf("callgen2lexlex\t%ld\n",operand);
+      break;
+    case OCcallgen2lexstoi:
+      pari_printf("callgen2lexstoi\t%ld\n",operand);
+      break;
+    case OCcallptrlex:
+      pari_printf("callptrlex\t%ld\n",operand);
+      break;
+    case OCcallptrlexlex:
+      pari_printf("callptrlexlex\t%ld\n",operand);
+      break;
+    case OCcallptrlexstoi:
+      pari_printf("callptrlexstoi\t%ld\n",operand);
+      break;
     case OCprecreal:
       pari_printf("precreal\n");
       break;
@@ -2278,6 +2482,11 @@ opcode_need_relink(op_code opcode)
   case OCstorelex:
   case OCstoreptr:
   case OCsimpleptrlex:
+  case OCcallgen2lexlex:
+  case OCcallgen2lexstoi:
+  case OCcallptrlex:
+  case OCcallptrlexlex:
+  case OCcallptrlexstoi:
   case OCnewptrlex:
   case OCpushptr:
   case OCstackgen:
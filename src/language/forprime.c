@@ -11,6 +11,10 @@ Check the License for details. You should have received a copy of it, along
 with the package; see the file 'COPYING'. If not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
 
+#include "paricfg.h"
+#ifdef HAS_MMAP
+#include <sys/mman.h>
+#endif
 #include "pari.h"
 #include "paripriv.h"
 #include "anal.h"
@@ -23,6 +27,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
 
 static ulong _maxprime = 0;
 static ulong diffptrlen;
+/* when diffptr lives in a mapped prime table file: the mapping, else NULL */
+static void *diffptrmap = NULL;
+static size_t diffptrmaplen;
 
 /* Building/Rebuilding the diffptr table. The actual work is done by the
  * following two subroutines;  the user entry point is the function
@@ -359,25 +366,21 @@ sieve_chunk(byteptr known_primes, ulong s, byteptr data, ulong n)
   }
 }
 
-/* assume maxnum <= 436273289 < 2^29 */
+/* p1 contains the prime differences up to *lastp (odd), *lenp bytes including
+ * the final 0 sentinel, and has room for the differences up to maxnum (odd).
+ * Extend it in place up to maxnum; assume *lastp^2 >= maxnum */
 static void
-initprimes0(ulong maxnum, long *lenp, ulong *lastp, byteptr p1)
+initprimes_extend(ulong maxnum, long *lenp, ulong *lastp, byteptr p1)
 {
   pari_sp av = avma, bot = pari_mainstack->bot;
-  long alloced, psize;
-  byteptr q, end, p, end1, plast, curdiff;
-  ulong last, remains, curlow, rootnum, asize;
+  long alloced;
+  byteptr q, end, p, plast, curdiff;
+  ulong last = *lastp, remains, curlow, rootnum, asize;
   ulong prime_above;
   byteptr p_prime_above;
 
-  maxnum |= 1; /* make it odd. */
-  /* base case */
-  if (maxnum < 1ul<<17) { initprimes1(maxnum>>1, lenp, lastp, p1); return; }
-
-  /* Checked to be enough up to 40e6, attained at 155893 */
+  if (maxnum <= last) return;
   rootnum = usqrt(maxnum) | 1;
-  initprimes1(rootnum>>1, &psize, &last, p1);
-  end1 = p1 + psize - 1;
   remains = (maxnum - last) >> 1; /* number of odd numbers to check */
 
   /* we access primes array of psize too; but we access it consecutively,
@@ -392,7 +395,7 @@ initprimes0(ulong maxnum, long *lenp, ulong *lastp, byteptr p1)
     p = (byteptr)stack_malloc(asize+1);
   end = p + asize; /* the 0 sentinel goes at end. */
   curlow = last + 2; /* First candidate: know primes up to last (odd). */
-  curdiff = end1;
+  curdiff = p1 + *lenp - 1; /* overwrite the 0 sentinel */
 
   /* During each iteration p..end-1 represents a range of odd
      numbers.  plast is a pointer which represents the last prime seen,
@@ -430,6 +433,19 @@ initprimes0(ulong maxnum, long *lenp, ulong *lastp, byteptr p1)
   if (alloced) pari_free(p); else avma = av;
 }
 
+/* assume maxnum <= 436273289 < 2^29 */
+static void
+initprimes0(ulong maxnum, long *lenp, ulong *lastp, byteptr p1)
+{
+  maxnum |= 1; /* make it odd. */
+  /* base case */
+  if (maxnum < 1ul<<17) { initprimes1(maxnum>>1, lenp, lastp, p1); return; }
+
+  /* Checked to be enough up to 40e6, attained at 155893 */
+  initprimes1((usqrt(maxnum) | 1)>>1, lenp, lastp, p1);
+  initprimes_extend(maxnum, lenp, lastp, p1);
+}
+
 ulong
 maxprime(void) { return diffptr ? _maxprime : 0; }
 
@@ -440,29 +456,165 @@ maxprime_check(ulong c) { if (_maxprime < c) pari_err_MAXPRIME(c); }
  * have enough fast primes to work, the RHS ensures that p_{n+1} - p_n < 255
  * (N.B. RHS would be incorrect since initprimes0 would make it odd, thereby
  * increasing it by 1) */
+static ulong
+primetable_bound(ulong maxnum)
+{
+  if (maxnum < 65537) return 65537;
+  if (maxnum > 436273289) return 436273289;
+  return maxnum;
+}
+/* room for the prime differences up to maxnum */
+static size_t
+primetable_size(ulong maxnum)
+{ return (size_t) (1.09 * maxnum/log((double)maxnum)) + 146; }
+
 byteptr
 initprimes(ulong maxnum, long *lenp, ulong *lastp)
 {
   byteptr t;
-  if (maxnum < 65537)
-    maxnum = 65537;
-  else if (maxnum > 436273289)
-    maxnum = 436273289;
-  t = (byteptr)pari_malloc((size_t) (1.09 * maxnum/log((double)maxnum)) + 146);
+  maxnum = primetable_bound(maxnum);
+  t = (byteptr)pari_malloc(primetable_size(maxnum));
   initprimes0(maxnum, lenp, lastp, t);
   return (byteptr)pari_realloc(t, *lenp);
 }
 
+/* truncate the prime table d to the primes <= maxnum */
+static void
+primetable_truncate(byteptr d, ulong maxnum, long *lenp, ulong *lastp)
+{
+  ulong p = 0;
+  byteptr q = d;
+  while (*q && p + *q <= maxnum) p += *q++;
+  if (*q) *q = 0; /* don't touch a mapped page needlessly */
+  *lenp = q + 1 - d;
+  *lastp = p;
+}
+
+/* free the prime table d, possibly mapped from a file */
+static void
+primetable_free(byteptr d, void *map, size_t maplen)
+{
+#ifdef HAS_MMAP
+  if (map) { munmap(map, maplen); return; }
+#endif
+  if (d) pari_free(d);
+}
+
+/* Set the prime table to contain the primes up to maxnum. An existing table
+ * is truncated or extended as needed, sieving only the missing range. */
 void
 initprimetable(ulong maxnum)
 {
   long len;
   ulong last;
-  byteptr p = initprimes(maxnum, &len, &last), old = diffptr;
+  byteptr p, old = diffptr;
+  void *map = diffptrmap;
+  size_t maplen = diffptrmaplen;
+
+  maxnum = primetable_bound(maxnum) | 1;
+  if (old && maxnum <= _maxprime)
+  {
+    if (maxnum == _maxprime) return;
+    primetable_truncate(old, maxnum, &len, &last);
+    diffptrlen = len; _maxprime = last;
+    if (!map) diffptr = (byteptr)pari_realloc(old, len);
+    return;
+  }
+  if (old)
+  {
+    p = (byteptr)pari_malloc(primetable_size(maxnum));
+    memcpy(p, old, diffptrlen);
+    len = diffptrlen; last = _maxprime;
+    initprimes_extend(maxnum, &len, &last, p);
+    p = (byteptr)pari_realloc(p, len);
+  }
+  else
+    p = initprimes(maxnum, &len, &last);
   diffptrlen = minss(diffptrlen, len);
   _maxprime  = minss(_maxprime,last); /*Protect against ^C*/
   diffptr = p; diffptrlen = len; _maxprime = last;
-  if (old) free(old);
+  diffptrmap = NULL;
+  primetable_free(old, map, maplen);
+}
+
+/* Prime table files: three ulongs (magic number, largest prime, length of
+ * the table including its final 0), followed by the table itself, which is
+ * mapped in memory when possible. */
+#define PRIMETAB_MAGIC 0x7072696dUL
+
+/* replace the prime table by the one in file s; return the largest prime in
+ * the new table, or 0 if s cannot be used (the table is then left alone) */
+ulong
+primetable_read(const char *s)
+{
+  ulong h[3];
+  size_t L;
+  byteptr d;
+  void *map = NULL;
+  FILE *f = fopen(s, "rb");
+
+  if (!f) return 0;
+  if (fread(h, sizeof(ulong), 3, f) != 3 || h[0] != PRIMETAB_MAGIC
+      || h[1] < 65537 || h[1] > 436273289
+      || h[2] < 2 || h[2] > primetable_size(h[1])
+      || fseek(f, 0, SEEK_END) || ftell(f) != (long)(3*sizeof(ulong) + h[2]))
+  { fclose(f); return 0; }
+  L = 3*sizeof(ulong) + h[2];
+#ifdef HAS_MMAP
+  map = mmap(NULL, L, PROT_READ|PROT_WRITE, MAP_PRIVATE, fileno(f), 0);
+  if (map == MAP_FAILED) map = NULL;
+#endif
+  if (map)
+    d = (byteptr)map + 3*sizeof(ulong);
+  else
+  {
+    d = (byteptr)pari_malloc(h[2]);
+    if (fseek(f, 3*sizeof(ulong), SEEK_SET) || fread(d, 1, h[2], f) != h[2])
+    { pari_free(d); fclose(f); return 0; }
+  }
+  fclose(f);
+  if (d[0] != 2 || d[h[2]-1]) { primetable_free(d, map, L); return 0; }
+  primetable_free(diffptr, diffptrmap, diffptrmaplen);
+  diffptr = d; diffptrlen = h[2]; _maxprime = h[1];
+  diffptrmap = map; diffptrmaplen = L;
+  return h[1];
+}
+
+/* write the prime table to file s, through a temporary file so that other
+ * processes may keep mapping the former s */
+void
+primetable_write(const char *s)
+{
+  ulong h[3];
+  int ok;
+  FILE *f;
+#ifdef UNIX
+  char *t = pari_sprintf("%s-%ld", s, (long)getpid());
+#else
+  char *t = pari_sprintf("%s.tmp", s);
+#endif
+  f = fopen(t, "wb");
+  if (!f) { pari_warn(warnfile, "write", s); pari_free(t); return; }
+  h[0] = PRIMETAB_MAGIC; h[1] = _maxprime; h[2] = diffptrlen;
+  ok = fwrite(h, sizeof(ulong), 3, f) == 3
+       && fwrite(diffptr, 1, diffptrlen, f) == diffptrlen;
+  if (fclose(f)) ok = 0;
+  if (!ok || rename(t, s))
+  {
+    (void)remove(t);
+    pari_warn(warnfile, "write", s);
+  }
+  pari_free(t);
+}
+
+/* as initprimetable, starting from the table in file s when it is usable.
+ * If it did not cover maxnum, save the extended table to s */
+void
+initprimetable_file(ulong maxnum, const char *s)
+{
+  ulong last = primetable_read(s);
+  initprimetable(maxnum);
+  if (last < _maxprime) primetable_write(s);
 }
 
 /* all init_primepointer_xx routines set *ptr to the corresponding place
@@ -598,6 +750,8 @@ u_forprime_sieve_arith_init(forprime_t *T, struct pari_sieve *psieve,
   T->psieve = psieve; /* unused for now */
   T->isieve = NULL; /* unused for now */
   T->b = b;
+  T->a = 0;
+  T->cache[0] = 0;
   if (maxp >= b) { /* [a,b] \subset prime table */
     u_forprime_set_prime_table(T, a);
     return 1;
@@ -744,14 +898,16 @@ void
 pari_init_primes(ulong maxprime)
 {
   ulong a = PARI_MODULAR_BASE, b = a + (1UL<<20);
-  initprimetable(maxprime);
+  const char *s = GP_DATA? GP_DATA->primetablefile: NULL;
+  if (s) initprimetable_file(maxprime, s); else initprimetable(maxprime);
   pari_sieve_init(&pari_sieve_modular, a, b);
 }
 
 void
 pari_close_primes(void)
 {
-  pari_free(diffptr);
+  primetable_free(diffptr, diffptrmap, diffptrmaplen);
+  diffptrmap = NULL;
   pari_free(pari_sieve_modular.sieve);
 }
 
@@ -899,11 +1055,25 @@ NEXT_CHUNK:
   {
     if (T->q == 1)
     {
+      if (!T->cache[0])
+      {
 #ifdef LONG_IS_64BIT
-      if (T->p == (1UL<<63)) return T->p = 9223372036854775837UL;
-      if (T->p == 9223372036854775837UL) return T->p = 9223372036854775907UL;
+        if (T->p == (1UL<<63)) return T->p = 9223372036854775837UL;
+        if (T->p == 9223372036854775837UL) return T->p = 9223372036854775907UL;
 #endif
-      T->p = unextprime(T->p + 1);
+        /* T->a = largest integer scanned so far */
+        if (T->a < T->p) T->a = T->p;
+        while (T->a < T->b && !T->cache[0])
+          T->a = uprimes_batch(T->a, T->b, T->cache);
+        if (!T->cache[0])
+        { /* overflow ulong, switch to GEN */
+          if (T->b == ULONG_MAX) T->strategy = PRST_nextprime;
+          return 0;
+        }
+      }
+      shift_cache(T);
+      if (T->p > T->b) return 0;
+      return T->p;
     }
     else
     {
@@ -1252,7 +1252,7 @@ gp_alarm_handler(int sig)
   /*SYSV reset the signal handler in the handler*/
   (void)os_signal(sig,gp_alarm_handler);
 #endif
-  if (PARI_SIGINT_block) PARI_SIGINT_pending=sig;
+  if (PARI_SIGINT_block) { PARI_SIGINT_pending=sig; mt_sigint(); }
   else gp_alarm_fun();
   return;
 }
@@ -1279,6 +1279,102 @@ gp_allocatemem(GEN z)
     paristack_newrsize(newsize);
 }
 
+/********************************************************************/
+/*                                                                  */
+/*                     STACK HIGH-WATER MARKS                       */
+/*                                                                  */
+/********************************************************************/
+/* Largest number of bytes used on the PARI stack, and on the threads
+ * stacks, recorded in the stackfile by previous sessions */
+static ulong stackfile_S, stackfile_T;
+/* Largest high-water mark of the PARI stack in this session */
+static ulong gp_stackhwm;
+/* did a command overflow the stack in this session ? */
+static int gp_stackovf;
+/* bound for the recorded marks when parisizemax / threadsizemax are 0 */
+#ifdef LONG_IS_64BIT
+#  define STACKFILE_MAX (1UL << 32)
+#else
+#  define STACKFILE_MAX (1UL << 28)
+#endif
+
+static ulong
+stackfile_max(ulong v) { return v? v: STACKFILE_MAX; }
+
+/* Called after each command. After an e_STACK, we do not know how much
+ * memory the command needed: assume twice the current size, only for the
+ * first overflow in the session and up to parisizemax. The high-water mark
+ * of the failed command is the stack size itself: forget it */
+void
+gp_stack_hwm_record(long numerr)
+{
+  ulong s = paristack_hwm();
+  if (numerr == e_STACK)
+  {
+    if (gp_stackovf) s = 0;
+    else
+    {
+      ulong m = stackfile_max(pari_mainstack->vsize);
+      s = pari_mainstack->size << 1; if (s > m) s = m;
+      gp_stackovf = 1;
+    }
+    paristack_hwm_reset();
+  }
+  if (s > gp_stackhwm) gp_stackhwm = s;
+}
+
+/* stack size for a computation using up to s bytes: leave some room, so
+ * that gc_needed is not triggered more often than in the recorded run */
+static ulong
+stackfile_size(ulong s) { return s + (s >> 2); }
+
+/* read the high-water marks recorded in file s. At startup, increase
+ * parisize to accomodate them; threadsize can be increased at any time */
+static void
+stackfile_read(const char *s, long flag)
+{
+  FILE *f = fopen(s, "r");
+  char key[16];
+  ulong n, t;
+  stackfile_S = stackfile_T = 0; /* forget the marks of a previous file */
+  if (!f) return;
+  while (fscanf(f, "%15s %lu", key, &n) == 2)
+  {
+    if (!strcmp(key, "stack")) stackfile_S = n;
+    else if (!strcmp(key, "thread")) stackfile_T = n;
+  }
+  fclose(f);
+  if (flag == d_INITRC && stackfile_S)
+  {
+    size_t v = pari_mainstack->vsize;
+    ulong m = stackfile_max(v);
+    n = stackfile_size(stackfile_S); if (n > m) n = m;
+    if (n > pari_mainstack->rsize) paristack_setsize(n, v);
+  }
+  if (stackfile_T)
+  {
+    ulong m = stackfile_max(GP_DATA->threadsizemax);
+    n = stackfile_size(stackfile_T); if (n > m) n = m;
+    t = GP_DATA->threadsize? GP_DATA->threadsize: pari_mainstack->rsize;
+    if (n > t) GP_DATA->threadsize = n;
+  }
+}
+
+/* Called on exit: record the high-water marks of this session. Marks of
+ * previous sessions decay: they are halved unless reached again */
+void
+gp_stackfile_write(void)
+{
+  const char *s = GP_DATA->stackfile;
+  FILE *f;
+  if (!s) return;
+  f = fopen(s, "w");
+  if (!f) { pari_warn(warnfile, "write", s); return; }
+  fprintf(f, "stack %lu\nthread %lu\n", maxuu(stackfile_S >> 1, gp_stackhwm),
+             maxuu(stackfile_T >> 1, mt_stack_hwm()));
+  fclose(f);
+}
+
 GEN
 gp_input(void)
 {
@@ -1659,6 +1755,20 @@ sd_readline(const char *v, long flag)
     (void)sd_toggle(GP_DATA->readline_state? "1": "0", d_SILENT, "readline", &(GP_DATA->use_readline));
   return res;
 }
+GEN
+sd_stackfile(const char *v, long flag)
+{
+  GEN r = sd_string(v, flag, "stackfile", &GP_DATA->stackfile);
+  if (v && !*v)
+  {
+    free(GP_DATA->stackfile);
+    GP_DATA->stackfile = NULL;
+  }
+  else if (v)
+    stackfile_read(GP_DATA->stackfile, flag);
+  return r;
+}
+
 GEN
 sd_histfile(const char *v, long flag)
 {
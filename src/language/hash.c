@@ -275,7 +275,7 @@ glue(ulong h, ulong a) { return 404936533*h + a; }
 ulong
 hash_GEN(GEN x)
 {
-  ulong h = x[0];
+  ulong h = x[0] & ~CLONEBIT;
   long tx = typ(x), lx, i;
   switch(tx)
   { /* non recursive types */
@@ -284,14 +284,21 @@ hash_GEN(GEN x)
       h &= TYPBITS;
       for (i = 1; i < lx; i++) h = glue(h, uel(x,i));
       return h;
+    case t_STR: /* the padding of the last word is undefined */
+      return glue(h & TYPBITS, hash_str(GSTR(x)));
     case t_REAL:
-    case t_STR:
     case t_VECSMALL:
       lx = lg(x);
       for (i = 1; i < lx; i++) h = glue(h, uel(x,i));
       return h;
     /* one more special case */
     case t_LIST:
+      if (list_typ(x) != t_LIST_RAW)
+      { /* maps: must not depend on the internal layout */
+        pari_sp av = avma;
+        h = glue(h, hash_GEN(maptomat_shallow(x)));
+        avma = av; return h;
+      }
       x = list_data(x);
       if (!x) return h;
       /* fall through */
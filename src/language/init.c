@@ -148,10 +148,56 @@ static THREAD GEN cur_block; /* current block in block list */
 static THREAD long NUM;
 #endif
 
+/* Small blocks are allocated from a pool: their size (including the header)
+ * is rounded up to one of the BL_NCLASS size classes below, four per power
+ * of 2, and they are carved out of BL_SLAB words slabs, obtained from malloc
+ * and never freed until the thread exits. Freed blocks are kept in a free
+ * list per class, for the next allocation in the same class. Larger blocks
+ * are malloc'ed directly. All this is private to each thread, as the block
+ * list itself: a block must be freed by the thread which allocated it. */
+#define BL_NCLASS 21
+#define BL_SLAB 8192
+static const long bl_csize[BL_NCLASS] =
+{ 8, 10,12,14,16, 20,24,28,32, 40,48,56,64, 80,96,112,128, 160,192,224,256 };
+static THREAD GEN bl_free[BL_NCLASS]; /* free lists */
+static THREAD long bl_nfree[BL_NCLASS]; /* their lengths */
+static THREAD GEN bl_slab; /* last slab, x[0] points to the previous one */
+static THREAD long bl_slab_n, bl_slab_left; /* number of slabs, words left */
+
+/* size class of a block of n words, including the header; -1 if too large */
+INLINE long
+bl_getclass(ulong n)
+{
+  long e;
+  if (n <= 8) return 0;
+  if (n > 256) return -1;
+  n--; e = expu(n); /* 3 <= e <= 7 */
+  return ((e-3) << 2) + ((n >> (e-2)) & 3) + 1;
+}
+
+static GEN
+bl_pool_get(long c)
+{
+  long l = bl_csize[c];
+  GEN y = bl_free[c];
+  if (y) { bl_free[c] = (GEN)y[0]; bl_nfree[c]--; return y; }
+  if (bl_slab_left < l)
+  {
+    GEN S = (GEN)pari_malloc(BL_SLAB*sizeof(long));
+    S[0] = (long)bl_slab; bl_slab = S; bl_slab_n++;
+    bl_slab_left = BL_SLAB - 1;
+  }
+  y = bl_slab + (BL_SLAB - bl_slab_left); bl_slab_left -= l;
+  return y;
+}
+
 static void
 pari_init_blocks(void)
 {
+  long c;
   next_block = 0; cur_block = NULL;
+  for (c = 0; c < BL_NCLASS; c++) { bl_free[c] = NULL; bl_nfree[c] = 0; }
+  bl_slab = NULL; bl_slab_n = bl_slab_left = 0;
 #ifdef DEBUG
   NUM = 0;
 #endif
@@ -161,9 +207,12 @@ static void
 pari_close_blocks(void)
 {
   while (cur_block) killblock(cur_block);
+  while (bl_slab) { GEN S = bl_slab; bl_slab = (GEN)S[0]; pari_free(S); }
+  pari_init_blocks();
 }
 
 /* Return x, where:
+ * x[-5]: size class (-1 if malloc-ed directly)
  * x[-4]: reference count
  * x[-3]: adress of next block
  * x[-2]: adress of preceding block.
@@ -172,8 +221,17 @@ pari_close_blocks(void)
 GEN
 newblock(size_t n)
 {
-  long *x = (long *) pari_malloc((n + BL_HEAD)*sizeof(long)) + BL_HEAD;
+  long c = bl_getclass(n + BL_HEAD), *x;
 
+  if (c < 0)
+    x = (long *) pari_malloc((n + BL_HEAD)*sizeof(long)) + BL_HEAD;
+  else
+  {
+    BLOCK_SIGINT_START;
+    x = bl_pool_get(c) + BL_HEAD;
+    BLOCK_SIGINT_END;
+  }
+  bl_class(x) = c;
   bl_refc(x) = 1;
   bl_next(x) = NULL;
   bl_prev(x) = cur_block;
@@ -201,6 +259,25 @@ gcloneref(GEN x)
 void
 gclone_refc(GEN x) { ++bl_refc(x); }
 
+/* Promote x to the old generation recorded in s (a pari_stack of GEN): x is
+ * cloned, hence ignored by gerepileall_young, until gpromote_release(s) */
+GEN
+gpromote(pari_stack *s, GEN x)
+{
+  GEN y = gclone(x);
+  pari_stack_pushp(s, (void*)y); return y;
+}
+
+/* kill all objects promoted to s, which becomes empty */
+void
+gpromote_release(pari_stack *s)
+{
+  GEN *v = *(GEN**)pari_stack_base(s);
+  long i;
+  for (i = s->n-1; i >= 0; i--) gunclone(v[i]);
+  s->n = 0;
+}
+
 void
 gunclone(GEN x)
 {
@@ -215,7 +292,14 @@ gunclone(GEN x)
   if (bl_prev(x)) bl_next(bl_prev(x)) = bl_next(x);
   if (DEBUGMEM > 2)
     err_printf("killing block (no %ld): %08lx\n", bl_num(x), x);
-  free((void*)bl_base(x)); /* pari_free not needed: we already block */
+  if (bl_class(x) < 0)
+    free((void*)bl_base(x)); /* pari_free not needed: we already block */
+  else
+  {
+    long c = bl_class(x);
+    GEN y = (GEN)bl_base(x);
+    y[0] = (long)bl_free[c]; bl_free[c] = y; bl_nfree[c]++;
+  }
   BLOCK_SIGINT_END;
 #ifdef DEBUG
   err_printf("- %ld\n", NUM--);
@@ -321,6 +405,24 @@ getheap(void)
   return mkvec2s(T.n, T.l + BL_HEAD * T.n);
 }
 
+/* flag = 1: add the number of words reserved by the block pool, and the
+ * number of words in its free lists */
+GEN
+getheap0(long flag)
+{
+  struct getheap_t T = { 0, 0 };
+  long c, f;
+  switch(flag)
+  {
+    case 0: return getheap();
+    case 1: break;
+    default: pari_err_FLAG("getheap");
+  }
+  traverseheap(&f_getheap, &T);
+  for (c = f = 0; c < BL_NCLASS; c++) f += bl_nfree[c] * bl_csize[c];
+  return mkvec4s(T.n, T.l + BL_HEAD * T.n, bl_slab_n * BL_SLAB, f);
+}
+
 void
 traverseheap( void(*f)(GEN, void *), void *data )
 {
@@ -672,6 +774,14 @@ fix_size(size_t a)
   return b;
 }
 
+/* The high-water mark is updated by new_chunk_resize, off the hot path of
+ * new_chunk: lim is kept HWM_STEP bytes below it, so that the mark misses
+ * less than HWM_STEP bytes */
+#define HWM_STEP 4096UL
+static void
+pari_mainstack_setlim(struct pari_mainstack *st)
+{ st->lim = (st->hwm > st->bot + HWM_STEP)? st->hwm - HWM_STEP: st->bot; }
+
 static void
 pari_mainstack_alloc(struct pari_mainstack *st, size_t rsize, size_t vsize)
 {
@@ -690,6 +800,7 @@ pari_mainstack_alloc(struct pari_mainstack *st, size_t rsize, size_t vsize)
   st->top = st->vbot+s;
   st->bot = st->top - st->size;
   st->memused = 0;
+  st->hwm = st->top; pari_mainstack_setlim(st);
 }
 
 static void
@@ -768,7 +879,9 @@ paristack_resize(ulong newsize)
   newsize = maxuu(minuu(newsize, vsize), pari_mainstack->size);
   pari_mainstack->size = newsize;
   pari_mainstack->bot = pari_mainstack->top - pari_mainstack->size;
-  pari_warn(warner,"increasing stack size to %lu",newsize);
+  pari_mainstack_setlim(pari_mainstack);
+  /* threads give the memory back after each task: keep quiet */
+  if (!mt_is_thread()) pari_warn(warner,"increasing stack size to %lu",newsize);
 }
 
 void
@@ -776,17 +889,26 @@ parivstack_reset(void)
 {
   pari_mainstack->size = pari_mainstack->rsize;
   pari_mainstack->bot = pari_mainstack->top - pari_mainstack->size;
+  pari_mainstack_setlim(pari_mainstack);
   pari_mainstack_mreset((void *)pari_mainstack->vbot,
                         pari_mainstack->bot-pari_mainstack->vbot);
 }
 
+/* called by new_chunk when avma - x words is below lim: the stack may
+ * need to grow, and we have a new high-water mark */
 void
 new_chunk_resize(size_t x)
 {
-  if (pari_mainstack->vsize==0
-    || x > (avma-pari_mainstack->vbot) / sizeof(long)) pari_err(e_STACK);
-  while (x > (avma-pari_mainstack->bot) / sizeof(long))
-    paristack_resize(0);
+  struct pari_mainstack *st = pari_mainstack;
+  pari_sp z;
+  if (x > (avma-st->bot) / sizeof(long))
+  {
+    if (st->vsize==0 || x > (avma-st->vbot) / sizeof(long)) pari_err(e_STACK);
+    while (x > (avma-st->bot) / sizeof(long)) paristack_resize(0);
+  }
+  z = avma - x*sizeof(long);
+  if (z < st->hwm) st->hwm = z;
+  pari_mainstack_setlim(st);
 }
 
 /*********************************************************************/
@@ -806,6 +928,18 @@ pari_thread_valloc(struct pari_thread *t, size_t s, size_t v, GEN arg)
 /* Initial PARI thread structure t with a stack of size s and
  * argument arg */
 
+/* Maximal size of the stack of a thread, whose stack has size s: the value
+ * of threadsizemax, else parisizemax if it is larger than s, so that the
+ * threads stacks may grow when the main stack can */
+
+size_t
+pari_thread_vsize(size_t s)
+{
+  size_t v = GP_DATA->threadsizemax;
+  if (!v && pari_mainstack->vsize > s) v = pari_mainstack->vsize;
+  return v;
+}
+
 void
 pari_thread_alloc(struct pari_thread *t, size_t s, GEN arg)
 {
@@ -860,6 +994,16 @@ pari_thread_start(struct pari_thread *t)
   return t->data;
 }
 
+/* Prepare a running thread for a new task: restore the states recorded by
+ * the last pari_thread_sync, as pari_thread_start would */
+void
+pari_thread_resync(void)
+{
+  pari_init_rand();
+  pari_thread_init_seadata();
+  pari_thread_sync_varstate();
+}
+
 /*********************************************************************/
 /*                       LIBPARI INIT / CLOSE                        */
 /*********************************************************************/
@@ -978,6 +1122,8 @@ pari_close_opts(ulong init_opts)
     free((void*)GP_DATA->prompt);
     free((void*)GP_DATA->prompt_cont);
     free((void*)GP_DATA->histfile);
+    if (GP_DATA->stackfile) free((void*)GP_DATA->stackfile);
+    if (GP_DATA->primetablefile) free((void*)GP_DATA->primetablefile);
   }
   BLOCK_SIGINT_END;
 }
@@ -1432,7 +1578,7 @@ pari_err2str(GEN e)
       size_t rsize = numerr == e_STACKTHREAD && GP_DATA->threadsize ?
                                 GP_DATA->threadsize: pari_mainstack->rsize;
       size_t vsize = numerr == e_STACK? pari_mainstack->vsize:
-                                        GP_DATA->threadsizemax;
+                                        pari_thread_vsize(rsize);
       char *buf = (char *) pari_malloc(512*sizeof(char));
       if (vsize)
       {
@@ -1894,6 +2040,63 @@ taille0(GEN x)
   return n;
 }
 
+/* [copy_bin_flat:] size (number of words) required for gcopy_av_flat(x) */
+static long
+taille_flat(GEN x)
+{
+  long i,n,lx, tx = typ(x);
+  switch(tx)
+  { /* non recursive types */
+    case t_INT: return lgefint(x);
+    case t_REAL:
+    case t_STR:
+    case t_VECSMALL: return lg(x);
+
+    /* one more special case */
+    case t_LIST:
+    {
+      GEN L = list_data(x);
+      return L? 3 + taille_flat(L): 3;
+    }
+  }
+  n = lx = lg(x);
+  for (i=lontyp[tx]; i<lx; i++) n += taille_flat(gel(x,i));
+  return n;
+}
+
+/* [copy_bin_flat:] same as gcopy_avma, but t_LISTs are copied in the same
+ * area, as unfinalized lists */
+static GEN
+gcopy_av_flat(GEN x, pari_sp *AVMA)
+{
+  long i, lx, tx = typ(x);
+  GEN y;
+
+  switch(tx)
+  { /* non recursive types */
+    case t_INT:
+      *AVMA = (pari_sp)icopy_avma(x, *AVMA);
+      return (GEN)*AVMA;
+    case t_REAL: case t_STR: case t_VECSMALL:
+      *AVMA = (pari_sp)leafcopy_avma(x, *AVMA);
+      return (GEN)*AVMA;
+
+    /* one more special case */
+    case t_LIST:
+    {
+      GEN z = list_data(x);
+      y = cgetlist_avma(AVMA);
+      y[1] = evaltyp(list_typ(x));
+      list_data(y) = z? gcopy_av_flat(z, AVMA): NULL;
+      return y;
+    }
+  }
+  y = cgetg_copy_avma(x, &lx, AVMA);
+  if (lontyp[tx] == 1) i = 1; else { y[1] = x[1]; i = 2; }
+  for (; i<lx; i++) gel(y,i) = gcopy_av_flat(gel(x,i), AVMA);
+  return y;
+}
+
 /* How many words do we need to allocate to copy x ? t_LIST is a special case
  * since list_data() is malloc'ed later, in list_internal_copy() */
 static long
@@ -1927,6 +2130,47 @@ gsizeword(GEN x)
 long
 gsizebyte(GEN x) { return gsizeword(x) * sizeof(long); }
 
+/* [copy_bin_ref:] is x in one of the n ranges [R[2i], R[2i+1][ ? */
+static int
+inranges(GEN x, pari_sp *R, long n)
+{
+  long i;
+  for (i = 0; i < 2*n; i += 2)
+    if ((pari_sp)x >= R[i] && (pari_sp)x < R[i+1]) return 1;
+  return 0;
+}
+
+/* [copy_bin_ref:] size (number of words) required for gcopy_av0_ref(x) */
+static long
+taille0_ref(GEN x, pari_sp *R, long n)
+{
+  long i, m, lx, tx = typ(x);
+  if (!is_recursive_t(tx) || tx == t_LIST) return taille0(x);
+  m = lx = lg(x);
+  for (i=lontyp[tx]; i<lx; i++)
+    if (!inranges(gel(x,i), R, n)) m += taille0_ref(gel(x,i), R, n);
+  return m;
+}
+
+/* same as gcopy_av0, but components in the ranges R are not copied: their
+ * address is stored with the low bit set */
+static GEN
+gcopy_av0_ref(GEN x, pari_sp *AVMA, pari_sp *R, long n)
+{
+  long i, lx, tx = typ(x);
+  GEN y;
+  if (!is_recursive_t(tx) || tx == t_LIST) return gcopy_av0(x, AVMA);
+  y = cgetg_copy_avma(x, &lx, AVMA);
+  if (lontyp[tx] == 1) i = 1; else { y[1] = x[1]; i = 2; }
+  for (; i<lx; i++)
+  {
+    GEN c = gel(x,i);
+    gel(y,i) = inranges(c, R, n)? (GEN)((ulong)c | 1UL)
+                                : gcopy_av0_ref(c, AVMA, R, n);
+  }
+  return y;
+}
+
 /* return a clone of x structured as a gcopy */
 GENbin*
 copy_bin(GEN x)
@@ -1953,6 +2197,142 @@ copy_bin_canon(GEN x)
   p->base= (GEN)AVMA; return p;
 }
 
+/* [write_bin_canon:] write the canonical copy of x, in post-order: the
+ * components of an object are written before the object itself, which can
+ * then store their addresses. S->pos is the address of the next word. */
+#define BINWR_BUF 1024
+typedef struct {
+  pari_sp pos;
+  void *E;
+  void (*wr)(void *E, GEN w, long n);
+  long n, buf[BINWR_BUF]; /* pending words */
+} binwr_t;
+
+static void
+binwr_flush(binwr_t *S)
+{ if (S->n) { S->wr(S->E, S->buf, S->n); S->n = 0; } }
+
+/* room for the next n words in the buffer; NULL if n is too large: the
+ * caller then writes them through S->wr */
+static GEN
+binwr_get(binwr_t *S, long n)
+{
+  GEN b;
+  S->pos += n*sizeof(long);
+  if (S->n + n > BINWR_BUF) { binwr_flush(S); if (n > BINWR_BUF) return NULL; }
+  b = S->buf + S->n; S->n += n; return b;
+}
+
+static GEN
+gwrite_canon(GEN x, binwr_t *S)
+{
+  long i, lx, tx = typ(x);
+  pari_sp av;
+  GEN y, a, b;
+
+  switch(tx)
+  { /* non recursive types */
+    case t_INT:
+    {
+      int big;
+      if (!signe(x)) return NULL; /* special marker */
+      av = avma; a = (GEN)S->pos; lx = lgefint(x);
+      big = !(b = binwr_get(S, lx)); if (big) b = new_chunk(lx);
+      b[0] = evaltyp(t_INT)|evallg(lx);
+      b[1] = x[1]; y = int_MSW(x);
+      for (i=2; i<lx; i++, y = int_precW(y)) b[i] = *y;
+      if (big) { S->wr(S->E, b, lx); avma = av; }
+      return a;
+    }
+    case t_REAL: case t_STR: case t_VECSMALL:
+      a = (GEN)S->pos; lx = lg(x);
+      if (!(b = binwr_get(S, lx)))
+      {
+        long h = x[0] & (~CLONEBIT);
+        S->wr(S->E, &h, 1); S->wr(S->E, x+1, lx-1); return a;
+      }
+      b[0] = x[0] & (~CLONEBIT);
+      for (i=1; i<lx; i++) b[i] = x[i];
+      return a;
+
+    /* one more special case */
+    case t_LIST:
+    {
+      GEN z = list_data(x);
+      long t = list_typ(x);
+      z = z? gwrite_canon(z, S): NULL;
+      a = (GEN)S->pos; b = binwr_get(S, 3);
+      b[0] = _evallg(3) | evaltyp(t_LIST);
+      b[1] = z? evaltyp(t)|evallg(lg(list_data(x))-1): evaltyp(t);
+      b[2] = (long)z; return a;
+    }
+    default:
+      av = avma; lx = lg(x); y = new_chunk(lx);
+      y[0] = x[0] & (~CLONEBIT);
+      if (lontyp[tx] == 1) i = 1; else { y[1] = x[1]; i = 2; }
+      for (; i<lx; i++) gel(y,i) = gwrite_canon(gel(x,i), S);
+      a = (GEN)S->pos;
+      if ((b = binwr_get(S, lx))) for (i=0; i<lx; i++) b[i] = y[i];
+      else S->wr(S->E, y, lx);
+      avma = av; return a;
+  }
+}
+
+/* write the GENbin copy_bin_canon(x) through wr(E, w, n), n words at a
+ * time, without building it: first len, x and base (only len if x is an
+ * exact zero), then the data. The data is laid out differently, as if it
+ * started at address base = sizeof(long), but bin_copy restores the same
+ * object. Only uses the stack for the object being written and its
+ * ancestors. */
+void
+write_bin_canon(GEN x, void *E, void (*wr)(void *E, GEN w, long n))
+{
+  long L = taille0_canon(x), h[3], l;
+  binwr_t S;
+
+  h[0] = L;
+  if (!L) { wr(E, h, 1); return; }
+  switch(typ(x))
+  {
+    case t_INT: l = lgefint(x); break;
+    case t_LIST: l = 3; break;
+    default: l = lg(x);
+  }
+  h[2] = sizeof(long);
+  h[1] = h[2] + (L - l)*sizeof(long); /* x comes last */
+  wr(E, h, 3);
+  S.pos = (pari_sp)h[2]; S.E = E; S.wr = wr; S.n = 0;
+  (void)gwrite_canon(x, &S); binwr_flush(&S);
+}
+
+/* same as copy_bin, but self-contained: exact zeros are copied and t_LISTs
+ * stored inline, so that the data can be used in place after rebasing */
+GENbin*
+copy_bin_flat(GEN x)
+{
+  long t = taille_flat(x);
+  GENbin *p = (GENbin*)pari_malloc(sizeof(GENbin) + t*sizeof(long));
+  pari_sp AVMA = (pari_sp)(GENbinbase(p) + t);
+  p->rebase = &shiftaddress;
+  p->len = t;
+  p->x   = gcopy_av_flat(x, &AVMA);
+  p->base= (GEN)AVMA; return p;
+}
+
+/* same as copy_bin, except that the components of x in one of the n ranges
+ * [R[2i], R[2i+1][ are referenced instead of copied */
+GENbin*
+copy_bin_ref(GEN x, pari_sp *R, long n)
+{
+  long t = taille0_ref(x, R, n);
+  GENbin *p = (GENbin*)pari_malloc(sizeof(GENbin) + t*sizeof(long));
+  pari_sp AVMA = (pari_sp)(GENbinbase(p) + t);
+  p->rebase = &shiftaddress_ref;
+  p->len = t;
+  p->x   = gcopy_av0_ref(x, &AVMA, R, n);
+  p->base= (GEN)AVMA; return p;
+}
+
 GEN
 gclone(GEN x)
 {
@@ -2011,6 +2391,25 @@ shiftaddress(GEN x, long dec)
   }
 }
 
+/* same as shiftaddress, for copy_bin_ref: leave references alone */
+void
+shiftaddress_ref(GEN x, long dec)
+{
+  long i, lx, tx = typ(x);
+  if (!is_recursive_t(tx)) return;
+  if (tx == t_LIST) { shiftaddress(x, dec); return; }
+  lx = lg(x);
+  for (i=lontyp[tx]; i<lx; i++) {
+    if (!x[i]) gel(x,i) = gen_0;
+    else if (x[i] & 1L) x[i] &= ~1L;
+    else
+    {
+      x[i] += dec;
+      shiftaddress_ref(gel(x,i), dec);
+    }
+  }
+}
+
 void
 shiftaddress_canon(GEN x, long dec)
 {
@@ -2039,6 +2438,7 @@ shiftaddress_canon(GEN x, long dec)
         shiftaddress_canon(L, dec);
         list_data(x) = list_internal_copy(L, lg(L)); avma = av;
       }
+      break;
     }
     default:
       lx = lg(x);
@@ -2192,6 +2592,65 @@ gerepilecoeffssp(pari_sp av, pari_sp tetpil, long *g, int n)
   for (i=0; i<n; i++,g++) dec_gerepile((pari_sp*)g, av0, av, tetpil, dec);
 }
 
+/* as gcopy, but only copy the components lying in the young stack zone
+ * [lo, hi[; the others (older stack objects, clones, universal constants)
+ * are shared */
+static GEN
+gcopy_young(GEN x, pari_sp lo, pari_sp hi)
+{
+  long tx, lx, i;
+  GEN y;
+  if ((pari_sp)x < lo || (pari_sp)x >= hi) return x;
+  tx = typ(x);
+  switch(tx)
+  { /* non recursive types */
+    case t_INT: return icopy(x);
+    case t_REAL:
+    case t_STR:
+    case t_VECSMALL: return leafcopy(x);
+    /* one more special case */
+    case t_LIST: return listcopy(x);
+  }
+  y = cgetg_copy(x, &lx);
+  if (lontyp[tx] == 1) i = 1; else { y[1] = x[1]; i = 2; }
+  for (; i<lx; i++) gel(y,i) = gcopy_young(gel(x,i), lo, hi);
+  return y;
+}
+
+/* As gerepilemanysp, but copy first the part of the objects created since
+ * av, then clean the stack between av and avma. Components created before
+ * av or lying outside the stack (e.g. promoted by gpromote) are neither
+ * copied nor moved. */
+static void
+gerepilemany_young(pari_sp av, GEN* gptr[], int n)
+{
+  const pari_sp tetpil = avma;
+  int i;
+  for (i=0; i<n; i++) *gptr[i] = gcopy_young(*gptr[i], tetpil, av);
+  gerepilemanysp(av, tetpil, gptr, n);
+}
+
+void
+gerepileall_young(pari_sp av, int n, ...)
+{
+  int i;
+  va_list a; va_start(a, n);
+  if (n < 10)
+  {
+    GEN *gptr[10];
+    for (i=0; i<n; i++) gptr[i] = va_arg(a,GEN*);
+    gerepilemany_young(av, gptr, n);
+  }
+  else
+  {
+    GEN **gptr = (GEN**) pari_malloc(n*sizeof(GEN*));
+    for (i=0; i<n; i++) gptr[i] = va_arg(a,GEN*);
+    gerepilemany_young(av, gptr, n);
+    pari_free(gptr);
+  }
+  va_end(a);
+}
+
 static int
 dochk_gerepileupto(GEN av, GEN x)
 {
@@ -2315,6 +2774,33 @@ getdebugvar(void) { return DEBUGVAR; }
 long
 getstack(void) { return pari_mainstack->top-avma; }
 
+/* high-water mark: largest number of bytes used on the stack since the last
+ * call to paristack_hwm_reset (gp calls it before each command), up to
+ * HWM_STEP bytes */
+ulong
+paristack_hwm(void)
+{ return pari_mainstack->top - minuu(pari_mainstack->hwm, avma); }
+
+void
+paristack_hwm_reset(void)
+{
+  pari_mainstack->hwm = avma;
+  pari_mainstack_setlim(pari_mainstack);
+}
+
+long
+getstack0(long flag)
+{
+  switch(flag)
+  {
+    case 0: return getstack();
+    case 1: return paristack_hwm();
+    case 2: return mt_stack_hwm();
+  }
+  pari_err_FLAG("getstack");
+  return 0; /* LCOV_EXCL_LINE */
+}
+
 /*******************************************************************/
 /*                                                                 */
 /*                               timer_delay                             */
@@ -2470,6 +2956,48 @@ msgtimer(const char *format, ...)
 }
 long
 getabstime(void)  { return timer_get(&abstimer_T);}
+/* real time in T; from a monotonic clock if mono is set and one is
+ * available, with an arbitrary origin. Return 0 if no clock is available */
+static int
+walltime_read(pari_timer *T, int mono)
+{
+#if defined(USE_CLOCK_GETTIME)
+  struct timespec t;
+  int r = 1;
+#if defined(CLOCK_MONOTONIC)
+  if (mono) r = clock_gettime(CLOCK_MONOTONIC,&t);
+#endif
+  if (r && clock_gettime(CLOCK_REALTIME,&t)) return 0;
+  T->s = t.tv_sec; T->us = t.tv_nsec / 1000; return 1;
+#elif defined(USE_GETTIMEOFDAY)
+  struct timeval tv;
+  if (gettimeofday(&tv, NULL)) return 0;
+  T->s = tv.tv_sec; T->us = tv.tv_usec; return 1;
+#elif defined(USE_FTIMEFORWALLTIME)
+  struct timeb tp;
+  ftime(&tp);
+  T->s = tp.time; T->us = ((long)tp.millitm) * 1000; return 1;
+#else
+  (void)T; (void)mono; return 0;
+#endif
+}
+/* same as timer_start, measuring real time instead of CPU time when
+ * possible. The clock is monotonic: the delays are not affected by changes
+ * of the system time */
+void
+walltimer_start(pari_timer *T)
+{ if (!walltime_read(T, 1)) timer_start(T); }
+static long
+walltimer_aux(pari_timer *T, pari_timer *U)
+{
+  long s = T->s, us = T->us; walltimer_start(U);
+  return 1000 * (U->s - s) + (U->us - us + 500) / 1000;
+}
+long
+walltimer_delay(pari_timer *T) { return walltimer_aux(T, T); }
+long
+walltimer_get(pari_timer *T) { pari_timer t; return walltimer_aux(T, &t); }
+
 #if defined(USE_CLOCK_GETTIME) || defined(USE_GETTIMEOFDAY) \
  || defined(USE_FTIMEFORWALLTIME)
 static GEN
@@ -2483,17 +3011,10 @@ timetoi(ulong s, ulong m)
 GEN
 getwalltime(void)
 {
-#if defined(USE_CLOCK_GETTIME)
-  struct timespec t;
-  if (!clock_gettime(CLOCK_REALTIME,&t))
-    return timetoi(t.tv_sec, (t.tv_nsec + 500000)/1000000);
-#elif defined(USE_GETTIMEOFDAY)
-  struct timeval tv;
-  if (!gettimeofday(&tv, NULL))
-    return timetoi(tv.tv_sec, (tv.tv_usec + 500)/1000);
-#elif defined(USE_FTIMEFORWALLTIME)
-  struct timeb tp;
-  ftime(&tp); return timetoi(tp.time, tp.millitm);
+#if defined(USE_CLOCK_GETTIME) || defined(USE_GETTIMEOFDAY) \
+ || defined(USE_FTIMEFORWALLTIME)
+  pari_timer T;
+  if (walltime_read(&T, 0)) return timetoi(T.s, (T.us + 500)/1000);
 #endif
   return utoi(getabstime());
 }
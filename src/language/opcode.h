@@ -34,6 +34,9 @@ typedef enum {OCpushlong='A',OCpushgnil,OCpushgen,OCpushreal,OCpushstoi,OCpushva
               OCcowvardyn,OCcowvarlex,
               OCdup,OCstoreptr,OCcheckuserargs,
               OCitou,OCutoi,OCdefaultulong,
-              OCbitprecreal='@'} op_code;
+              OCbitprecreal='@',
+              /* superinstructions, see closure_peephole() */
+              OCcallgen2lexlex='?',OCcallgen2lexstoi='>',
+              OCcallptrlex='=',OCcallptrlexlex='<',OCcallptrlexstoi=';'} op_code;
 
 ENDEXTERN
@@ -690,7 +690,7 @@ vecexpr0(GEN vec, GEN code, GEN pred)
   {
     case t_LIST:
     {
-      if (list_typ(vec)==t_LIST_MAP)
+      if (list_typ(vec)!=t_LIST_RAW)
         vec = mapdomain_shallow(vec);
       else
         vec = list_data(vec);
@@ -0,0 +1,417 @@
+/* Copyright (C) 2017  The PARI group.
+
+This file is part of the PARI/GP package.
+
+PARI/GP is free software; you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation. It is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY WHATSOEVER.
+
+Check the License for details. You should have received a copy of it, along
+with the package; see the file 'COPYING'. If not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <errno.h>
+#include "pari.h"
+#include "paripriv.h"
+#include "mt.h"
+
+/* The workers are child processes, forked by mt_queue_start: they inherit
+ * the whole state of the master, including the worker closure, so nothing
+ * needs to be transmitted but the tasks. Each of them computes on a stack
+ * of its own, as a thread would, see mt_child_stack. Tasks and results are exchanged as
+ * GENbin through two ring buffers in memory shared with the master. Pipes
+ * are only used to wake up the other side when a ring changes, and to
+ * detect that it has died. A worker has at most one task at a time. */
+
+#define MT_RING (1UL<<20)
+#define mt_barrier() __sync_synchronize()
+
+struct mt_ring
+{
+  volatile size_t head, tail; /* bytes written / read so far */
+  char buf[MT_RING];
+};
+
+struct mt_chan
+{
+  struct mt_ring in, out; /* tasks, results */
+  volatile size_t hwm; /* stack high-water mark of the worker */
+};
+
+struct mt_worker
+{
+  pid_t pid;
+  struct mt_chan *ch;
+  int rd, wr; /* pipes from / to the worker */
+  int busy;
+  long workid;
+};
+
+struct mt_fstate
+{
+  struct mt_worker *w;
+  struct pollfd *fds;
+  long n, pending, last;
+  int nomore;
+  void (*sigpipe)(int);
+};
+
+static struct mt_fstate *pari_mt;
+static int mt_child; /* are we a worker process ? */
+static jmp_buf child_env;
+static struct pari_thread child_th; /* stack of a worker */
+static size_t mt_hwm; /* stack high-water mark of all workers */
+
+/* tell the other side that a ring has changed. If the pipe is full, it has
+ * not yet seen the previous notifications, which is enough */
+static void
+mt_wake(int fd)
+{
+  char c = 0;
+  if (write(fd, &c, 1) < 0) { /* EAGAIN or EPIPE: nothing to do */ }
+}
+
+/* wait for a notification of the other side, and flush the pending ones */
+static void
+mt_wait(int fd)
+{
+  struct pollfd p;
+  char c[64];
+  ssize_t r;
+  p.fd = fd; p.events = POLLIN;
+  if (poll(&p, 1, -1) < 0) return; /* EINTR, retry */
+  r = read(fd, c, sizeof(c));
+  if (r) return;
+  /* end of file: the other side is dead */
+  if (mt_child) _exit(0);
+  pari_err(e_MISC, "mt: a worker process died");
+}
+
+static void
+ring_write(struct mt_ring *r, const char *s, size_t n, int wake, int wait)
+{
+  while (n)
+  {
+    size_t h = r->head, o = h % MT_RING, m = MT_RING - (h - r->tail);
+    if (!m) { mt_wait(wait); continue; }
+    if (m > n) m = n;
+    if (m > MT_RING - o) m = MT_RING - o;
+    memcpy(r->buf + o, s, m);
+    mt_barrier();
+    r->head = h + m;
+    mt_wake(wake);
+    s += m; n -= m;
+  }
+}
+
+static void
+ring_read(struct mt_ring *r, char *s, size_t n, int wake, int wait)
+{
+  while (n)
+  {
+    size_t t = r->tail, o = t % MT_RING, m = r->head - t;
+    if (!m) { mt_wait(wait); continue; }
+    mt_barrier();
+    if (m > n) m = n;
+    if (m > MT_RING - o) m = MT_RING - o;
+    memcpy(s, r->buf + o, m);
+    mt_barrier();
+    r->tail = t + m;
+    mt_wake(wake);
+    s += m; n -= m;
+  }
+}
+
+/* a message is the error flag and the size of the GENbin, then the GENbin */
+static void
+mt_send(struct mt_ring *r, int wake, int wait, long err, GEN x)
+{
+  GENbin *p = copy_bin(x);
+  long hdr[2];
+  hdr[0] = err;
+  hdr[1] = sizeof(GENbin) + p->len*sizeof(long);
+  ring_write(r, (char*)hdr, sizeof(hdr), wake, wait);
+  ring_write(r, (char*)p, hdr[1], wake, wait);
+  pari_free(p);
+}
+
+static GEN
+mt_recv(struct mt_ring *r, int wake, int wait, long *err)
+{
+  long hdr[2];
+  GENbin *p;
+  ring_read(r, (char*)hdr, sizeof(hdr), wake, wait);
+  *err = hdr[0];
+  p = (GENbin*) pari_malloc(hdr[1]);
+  ring_read(r, (char*)p, hdr[1], wake, wait);
+  return bin_copy(p);
+}
+
+static void
+mt_child_loop(struct mt_chan *ch, int rd, int wr, GEN worker)
+{
+  pari_sp av = avma;
+  struct pari_evalstate state;
+  GEN work, done;
+  long err;
+  evalstate_save(&state);
+  if (setjmp(child_env))
+  {
+    GEN E = pari_err_last();
+    evalstate_restore(&state);
+    if (E == err_e_STACK) ch->hwm = maxuu(ch->hwm, pari_mainstack->size << 1);
+    mt_send(&ch->out, wr, rd, 1, E);
+    avma = av;
+  }
+  for(;;)
+  {
+    /* give back the memory used by the previous task beyond threadsize */
+    if (pari_mainstack->size > pari_mainstack->rsize) parivstack_reset();
+    work = mt_recv(&ch->in, wr, rd, &err);
+    done = closure_callgenvec(worker, work);
+    pari_flush(); err_flush();
+    ch->hwm = maxuu(ch->hwm, paristack_hwm());
+    mt_send(&ch->out, wr, rd, 0, done);
+    avma = av;
+  }
+}
+
+void
+mt_err_recover(long er)
+{
+  if (mt_child) longjmp(child_env, er);
+}
+void mt_sigint_block(void) { }
+void mt_sigint_unblock(void) { }
+void mt_sigint(void) { }
+
+int
+mt_is_parallel(void)
+{
+  return !!pari_mt;
+}
+
+int
+mt_is_thread(void)
+{
+  return mt_child;
+}
+
+void mt_broadcast(GEN code) {(void) code;}
+/* workers are processes: no data is shared */
+void mt_lock(void) { }
+void mt_unlock(void) { }
+
+void
+pari_mt_init(void)
+{
+  pari_mt = NULL;
+#ifdef _SC_NPROCESSORS_CONF
+  if (!pari_mt_nbthreads) pari_mt_nbthreads = sysconf(_SC_NPROCESSORS_CONF);
+#else
+  pari_mt_nbthreads = 1;
+#endif
+}
+
+void pari_mt_close(void) { }
+
+static GEN
+mtfork_queue_get(struct mt_state *junk, long *workid, long *pending)
+{
+  struct mt_fstate *mt = pari_mt;
+  struct mt_worker *w = NULL;
+  GEN done;
+  long i, err;
+  (void) junk;
+  if (!mt->nomore && mt->pending < mt->n) { *pending = mt->pending; return NULL; }
+  if (!mt->pending) { *pending = 0; return NULL; }
+  while (!w)
+  { /* a busy worker whose result has started to arrive, else wait */
+    long k = 0;
+    for (i = 0; i < mt->n; i++)
+    {
+      struct mt_worker *v = mt->w + (mt->last + i) % mt->n;
+      if (v->busy && v->ch->out.head != v->ch->out.tail) { w = v; break; }
+    }
+    if (w) break;
+    for (i = 0; i < mt->n; i++)
+      if (mt->w[i].busy)
+      {
+        mt->fds[k].fd = mt->w[i].rd;
+        mt->fds[k].events = POLLIN; k++;
+      }
+    if (poll(mt->fds, k, -1) < 0) continue; /* EINTR */
+    for (i = 0; i < k; i++)
+      if (mt->fds[i].revents) mt_wait(mt->fds[i].fd);
+  }
+  mt->last = (w - mt->w) + 1;
+  done = mt_recv(&w->ch->out, w->wr, w->rd, &err);
+  w->busy = 0;
+  *pending = --mt->pending;
+  if (workid) *workid = w->workid;
+  if (err)
+  {
+    if (err_get_num(done)==e_STACK)
+      pari_err(e_STACKTHREAD);
+    else
+      pari_err(0,done);
+  }
+  return done;
+}
+
+static void
+mtfork_queue_submit(struct mt_state *junk, long workid, GEN work)
+{
+  struct mt_fstate *mt = pari_mt;
+  struct mt_worker *w;
+  long i;
+  (void) junk;
+  if (!work) { mt->nomore = 1; return; }
+  mt->nomore = 0;
+  for (i = 0; mt->w[i].busy; i++) /* empty */;
+  w = mt->w + i;
+  w->workid = workid;
+  w->busy = 1;
+  mt->pending++;
+  mt_send(&w->ch->in, w->wr, w->rd, 0, work);
+}
+
+static void
+mt_worker_free(struct mt_worker *w, int kill_it)
+{
+  if (w->ch->hwm > mt_hwm) mt_hwm = w->ch->hwm;
+  if (kill_it) kill(w->pid, SIGKILL);
+  close(w->wr); /* idle workers exit when they see it */
+  while (waitpid(w->pid, NULL, 0) < 0 && errno == EINTR) /* empty */;
+  close(w->rd);
+  munmap((void*)w->ch, sizeof(struct mt_chan));
+}
+
+void
+mt_queue_reset(void)
+{
+  struct mt_fstate *mt = pari_mt;
+  long i;
+  BLOCK_SIGINT_START
+  if (DEBUGLEVEL>0 && mt->pending)
+    pari_warn(warner,"%ld discarded tasks (fork)", mt->pending);
+  for (i = 0; i < mt->n; i++) mt_worker_free(mt->w + i, mt->w[i].busy);
+  (void)os_signal(SIGPIPE, mt->sigpipe);
+  pari_free(mt->fds);
+  pari_free(mt->w);
+  pari_free(mt);
+  pari_mt = NULL;
+  BLOCK_SIGINT_END
+}
+
+static void
+mt_nonblock(int fd)
+{
+  (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/* In a new worker: compute on a stack of threadsize bytes, which may grow up
+ * to pari_thread_vsize() bytes as the stack of a thread. The copy of the
+ * stack of the master, holding the worker closure, stays mapped */
+static void
+mt_child_stack(void)
+{
+  size_t s = GP_DATA->threadsize? GP_DATA->threadsize: pari_mainstack->rsize;
+  pari_thread_valloc(&child_th, s, pari_thread_vsize(s), NULL);
+  pari_mainstack = &child_th.st;
+  avma = pari_mainstack->top;
+}
+
+/* fork a worker; return 0 on failure */
+static int
+mt_worker_start(struct mt_fstate *mt, long k, GEN worker)
+{
+  struct mt_worker *w = mt->w + k;
+  int to[2], from[2];
+  void *ch = mmap(NULL, sizeof(struct mt_chan), PROT_READ|PROT_WRITE,
+                  MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if (ch == MAP_FAILED) return 0;
+  if (pipe(to)) { munmap(ch, sizeof(struct mt_chan)); return 0; }
+  if (pipe(from))
+  {
+    close(to[0]); close(to[1]);
+    munmap(ch, sizeof(struct mt_chan)); return 0;
+  }
+  w->ch = (struct mt_chan*) ch;
+  w->ch->in.head = w->ch->in.tail = w->ch->out.head = w->ch->out.tail = 0;
+  w->ch->hwm = 0;
+  w->busy = 0;
+  w->pid = fork();
+  if (w->pid < 0)
+  {
+    close(to[0]); close(to[1]); close(from[0]); close(from[1]);
+    munmap(ch, sizeof(struct mt_chan)); return 0;
+  }
+  if (!w->pid)
+  { /* the master handles interrupts */
+    long i;
+    (void)os_signal(SIGINT, SIG_IGN);
+    for (i = 0; i < k; i++) { close(mt->w[i].rd); close(mt->w[i].wr); }
+    close(to[1]); close(from[0]);
+    mt_nonblock(to[0]); mt_nonblock(from[1]);
+    mt_child = 1; iferr_env = NULL;
+    PARI_SIGINT_block = 0; PARI_SIGINT_pending = 0; /* forked in a block */
+    mt_child_stack();
+    mt_child_loop(w->ch, to[0], from[1], worker);
+  }
+  close(to[0]); close(from[1]);
+  w->rd = from[0]; w->wr = to[1];
+  mt_nonblock(w->rd); mt_nonblock(w->wr);
+  return 1;
+}
+
+void
+mt_queue_start(struct pari_mt *pt, GEN worker)
+{
+  if (pari_mt || mt_child || pari_mt_nbthreads <= 1)
+    mtsingle_queue_start(pt, worker);
+  else
+  {
+    long n = pari_mt_nbthreads, k;
+    struct mt_fstate *mt;
+    BLOCK_SIGINT_START
+    mt = (struct mt_fstate*) pari_malloc(sizeof(struct mt_fstate));
+    mt->w = (struct mt_worker*) pari_malloc(n * sizeof(struct mt_worker));
+    mt->fds = (struct pollfd*) pari_malloc(n * sizeof(struct pollfd));
+    /* a worker may die while we are writing to it */
+    mt->sigpipe = os_signal(SIGPIPE, SIG_IGN);
+    pari_flush(); err_flush(); /* else the workers would print it again */
+    for (k = 0; k < n; k++)
+      if (!mt_worker_start(mt, k, worker)) break;
+    mt->n = k;
+    mt->pending = 0;
+    mt->last = 0;
+    mt->nomore = 0;
+    pari_mt = mt;
+    BLOCK_SIGINT_END
+    if (!k)
+    {
+      mt_queue_reset();
+      pari_err(e_MISC, "mt: could not create a worker process");
+    }
+    pt->get=&mtfork_queue_get;
+    pt->submit=&mtfork_queue_submit;
+    pt->end=&mt_queue_reset;
+  }
+}
+
+/* the workers see the memory of the master when they were forked, not the
+ * objects created afterwards: nothing can be shared */
+GEN
+mt_queue_share(struct pari_mt *pt, GEN x) { (void)pt; return x; }
+
+/* largest stack high-water mark of the workers, over all parallel sections */
+ulong
+mt_stack_hwm(void) { return mt_hwm; }
@@ -184,6 +184,7 @@ pari_MPI_child(void)
       done = closure_callgenvec(worker, work);
       send_GEN(done, 0);
       avma = av;
+      if (pari_mainstack->size > pari_mainstack->rsize) parivstack_reset();
       break;
     case PMPI_parisizemax:
       vsize = recvfrom_long(0);
@@ -227,6 +228,10 @@ mt_is_thread(void)
   return pari_MPI_rank;
 }
 
+/* workers are processes: no data is shared */
+void mt_lock(void) { }
+void mt_unlock(void) { }
+
 void
 mt_broadcast(GEN code)
 {
@@ -320,7 +325,7 @@ mt_queue_start(struct pari_mt *pt, GEN worker)
     struct mt_mstate *mt = &pari_mt_data;
     long i, n = minss(pari_mt_nbthreads, pari_MPI_size-1);
     long mtparisize = GP_DATA->threadsize? GP_DATA->threadsize: pari_mainstack->rsize;
-    long mtparisizemax = GP_DATA->threadsizemax;
+    long mtparisizemax = pari_thread_vsize(mtparisize);
     pari_mt = mt;
     mt->workid = (long*) pari_malloc(sizeof(long)*(n+1));
     for (i=1; i <= n; i++)
@@ -338,3 +343,11 @@ mt_queue_start(struct pari_mt *pt, GEN worker)
     pt->end=&mt_queue_reset;
   }
 }
+
+/* the tasks are sent to other processes: nothing can be shared */
+GEN
+mt_queue_share(struct pari_mt *pt, GEN x) { (void)pt; return x; }
+
+/* the stacks of the other processes are not monitored */
+ulong
+mt_stack_hwm(void) { return 0; }
@@ -63,16 +63,17 @@ mtstate_save(long *pending)
   *pending = mt_is_parallel();
 }
 
+/* terminate the parallel sections started since mtstate_save */
 void
 mtstate_restore(long *pending)
 {
-  if (!*pending && mt_is_parallel())
+  while (mt_is_parallel() > *pending)
     mt_queue_reset();
 }
 
 void
 mtstate_reset(void)
 {
-  if (mt_is_parallel())
+  while (mt_is_parallel())
     mt_queue_reset();
 }
@@ -11,6 +11,7 @@ Check the License for details. You should have received a copy of it, along
 with the package; see the file 'COPYING'. If not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
 #include <pthread.h>
+#include <signal.h>
 #include "pari.h"
 #include "paripriv.h"
 #include "mt.h"
@@ -18,36 +19,77 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
 #  include "../systems/mingw/mingw.h"
 #endif
 
+/* A work item: queued on the deque of some thread, then on the output list.
+ * Input and output are stored off-stack. */
+struct mt_task
+{
+  long workid;
+  int err; /* bin is an error, or NULL for a stack overflow */
+  GENbin *bin; /* input, then output */
+  struct mt_task *next;
+};
+
 struct mt_queue
 {
   long no;
-  pari_sp avma;
-  GEN input, output;
-  GEN worker;
-  long workid;
-  pthread_cond_t cond;
+  int alive, resync, busy, cancel;
+  struct mt_task *head, *tail; /* deque of pending tasks */
+  struct mt_task *task; /* task being processed */
+  struct mt_pstate *mt;
   pthread_mutex_t mut;
-  pthread_cond_t *pcond;
-  pthread_mutex_t *pmut;
 };
 
+/* Tasks are handed to the threads in chunks, round-robin. A thread takes
+ * tasks from its own deque, and steals from the others' when its deque is
+ * empty; the master is only woken up when it waits for some output. The
+ * number of pending tasks is bounded by MT_DEPTH per thread. */
+#define MT_DEPTH 4
+
 struct mt_pstate
 {
   pthread_t *th;
   struct pari_thread *pth;
   struct mt_queue *mq;
-  long n, nbint, last;
-  long pending;
-  pthread_cond_t pcond;
-  pthread_mutex_t pmut;
+  GEN worker;
+  struct mt_pstate *prev; /* enclosing section, for a nested one */
+  long depth; /* number of sections running in this thread */
+  long n, last, pending, nbsub;
+  int nomore;
+  struct mt_task *sub, *subtail; /* submitted, not yet handed to threads */
+  struct mt_task *out; /* outputs not yet returned by mt_queue_get */
+  struct mt_task *done, *donetail; /* outputs, protected by pmut */
+  long ntasks; /* tasks queued in deques, protected by wmut */
+  GEN *share; /* inputs shared with the threads, see mt_queue_share */
+  pari_sp *shareR; /* their extents */
+  long nshare;
+  size_t size, sizemax;
+  size_t hwm; /* largest stack high-water mark of the threads, see pmut */
+  pthread_cond_t pcond, wcond;
+  pthread_mutex_t pmut, wmut;
 };
 
+/* A parallel section started while another one is running, by the master
+ * or by a thread, gets its own threads, which are terminated at the end of
+ * the section. Their number is the share of idle pool threads available to
+ * the caller, so that the total number of threads running is at most about
+ * nbthreads; if it would be 1, the section is run sequentially. */
+
 static THREAD long mt_thread_no = -1;
-static struct mt_pstate *pari_mt;
+static THREAD struct mt_pstate *mt_thread_pool; /* pool of the thread */
+static THREAD struct mt_pstate *pari_mt; /* running parallel section */
+static struct mt_pstate *mt_pool; /* threads kept alive between sections */
+static long mt_nested; /* threads in nested sections, protected by mt_nmut */
+static size_t mt_hwm; /* stack high-water mark of all threads, idem */
+static pthread_mutex_t mt_nmut = PTHREAD_MUTEX_INITIALIZER;
+/* protects the process-global data of libpari, see mt_lock */
+static pthread_mutex_t mt_gmut = PTHREAD_MUTEX_INITIALIZER;
 
 #define LOCK(x) pthread_mutex_lock(x); do
 #define UNLOCK(x) while(0); pthread_mutex_unlock(x)
 
+void mt_lock(void) { pthread_mutex_lock(&mt_gmut); }
+void mt_unlock(void) { pthread_mutex_unlock(&mt_gmut); }
+
 void
 mt_sigint_block(void)
 {
@@ -62,20 +104,39 @@ mt_sigint_unblock(void)
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS,NULL);
 }
 
+/* append task t to the output list. After a stack overflow (no error
+ * object), the thread would have needed at least twice its stack */
+static void
+mt_queue_done(struct mt_pstate *mt, struct mt_task *t)
+{
+  size_t hwm = (t->err && !t->bin)? pari_mainstack->size << 1
+                                  : paristack_hwm();
+  t->next = NULL;
+  LOCK(&mt->pmut)
+  {
+    if (mt->donetail) mt->donetail->next = t; else mt->done = t;
+    mt->donetail = t;
+    if (hwm > mt->hwm) mt->hwm = hwm;
+    pthread_cond_signal(&mt->pcond);
+  } UNLOCK(&mt->pmut);
+}
+
 void
 mt_err_recover(long er)
 {
   (void) er;
   if (mt_thread_no>=0)
   {
-    struct mt_pstate *mt = pari_mt;
+    struct mt_pstate *mt = mt_thread_pool;
     struct mt_queue *mq = mt->mq+mt_thread_no;
-    GEN err = bin_copy(copy_bin(pari_err_last()));
-    LOCK(mq->pmut)
-    {
-      mq->output = err;
-      pthread_cond_signal(mq->pcond);
-    } UNLOCK(mq->pmut);
+    struct mt_task *t = mq->task;
+    GEN err = pari_err_last();
+    PARI_SIGINT_block = 1;
+    pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED,NULL);
+    t->err = 1;
+    t->bin = err == err_e_STACK? NULL: copy_bin(err);
+    mt_queue_done(mt, t);
+    mq->task = NULL;
     pthread_exit((void*)1);
   }
 }
@@ -89,7 +150,7 @@ mt_sigint(void)
 int
 mt_is_parallel(void)
 {
-  return !!pari_mt;
+  return pari_mt? pari_mt->depth: 0;
 }
 
 int
@@ -112,48 +173,96 @@ void pari_mt_init(void)
 #endif
 }
 
-void pari_mt_close(void) { }
+static void mt_pool_free(struct mt_pstate *mt);
+
+void
+pari_mt_close(void)
+{
+  if (mt_pool) { mt_pool_free(mt_pool); mt_pool = NULL; }
+}
 
 static void
 mt_queue_cleanup(void *arg)
 {
   (void) arg;
+  while (pari_mt) mt_queue_reset(); /* nested sections */
   pari_thread_close();
 }
 
+static void
+mt_queue_unlock(void *arg)
+{
+  pthread_mutex_unlock((pthread_mutex_t *) arg);
+}
+
+/* remove the first task from the deque of thread i */
+static struct mt_task *
+mt_queue_pop(struct mt_queue *mq)
+{
+  struct mt_task *t;
+  LOCK(&mq->mut)
+  {
+    t = mq->head;
+    if (t)
+    {
+      mq->head = t->next; t->next = NULL;
+      if (!mq->head) mq->tail = NULL;
+    }
+  } UNLOCK(&mq->mut);
+  return t;
+}
+
+/* some task is queued and reserved for thread no: take it from our own
+ * deque, else steal it from another one */
+static struct mt_task *
+mt_queue_take(struct mt_pstate *mt, long no)
+{
+  long i = no;
+  for(;;)
+  {
+    struct mt_task *t = mt_queue_pop(mt->mq+i);
+    if (t) return t;
+    if (++i == mt->n) i = 0;
+  }
+}
+
 static void*
 mt_queue_run(void *arg)
 {
   GEN args = pari_thread_start((struct pari_thread*) arg);
   pari_sp av = avma;
   struct mt_queue *mq = (struct mt_queue *) args;
+  struct mt_pstate *mt = mq->mt;
   mt_thread_no = mq->no;
+  mt_thread_pool = mt;
+  /* only the computation itself may be cancelled asynchronously */
+  PARI_SIGINT_block = 1;
   pthread_cleanup_push(mt_queue_cleanup,NULL);
-  LOCK(mq->pmut)
-  {
-    mq->avma = av;
-    pthread_cond_signal(mq->pcond);
-  } UNLOCK(mq->pmut);
   for(;;)
   {
+    struct mt_task *t;
     GEN work, done;
-    LOCK(&mq->mut)
-    {
-      while(!mq->input)
-        pthread_cond_wait(&mq->cond, &mq->mut);
-    } UNLOCK(&mq->mut);
-    avma = mq->avma;
-    work = mq->input;
+    pthread_mutex_lock(&mt->wmut);
+    pthread_cleanup_push(mt_queue_unlock, &mt->wmut);
+    mq->busy = 0;
+    while (!mt->ntasks)
+      pthread_cond_wait(&mt->wcond, &mt->wmut);
+    mt->ntasks--; mq->busy = 1;
+    pthread_cleanup_pop(1);
+    mq->task = t = mt_queue_take(mt, mq->no);
+    if (mq->resync) { pari_thread_resync(); mq->resync = 0; }
+    avma = av;
+    /* give back the memory used by the previous task beyond threadsize */
+    if (pari_mainstack->size > pari_mainstack->rsize) parivstack_reset();
+    work = bin_copy(t->bin); t->bin = NULL;
+    PARI_SIGINT_block = 0;
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS,NULL);
-    done = closure_callgenvec(mq->worker,work);
+    done = closure_callgenvec(mt->worker,work);
     pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED,NULL);
-    LOCK(mq->pmut)
-    {
-      mq->avma = av;
-      mq->input = NULL;
-      mq->output = done;
-      pthread_cond_signal(mq->pcond);
-    } UNLOCK(mq->pmut);
+    PARI_SIGINT_block = 1;
+    t->bin = copy_bin(done);
+    mt_queue_done(mt, t);
+    mq->task = NULL;
   }
   pthread_cleanup_pop(1);
 #ifdef __GNUC__
@@ -161,60 +270,95 @@ mt_queue_run(void *arg)
 #endif
 }
 
-static long
-mt_queue_check(struct mt_pstate *mt)
+/* hand the submitted tasks over to the threads */
+static void
+mt_queue_flush(struct mt_pstate *mt)
 {
-  long i;
-  for(i=0; i<mt->n; i++)
+  struct mt_task *t = mt->sub;
+  long k = mt->nbsub;
+  if (!k) return;
+  while (t)
   {
-    struct mt_queue *mq = mt->mq+i;
-    if (mq->output) return i;
+    struct mt_queue *mq = mt->mq + mt->last;
+    struct mt_task *next = t->next;
+    t->next = NULL;
+    LOCK(&mq->mut)
+    {
+      if (mq->tail) mq->tail->next = t; else mq->head = t;
+      mq->tail = t;
+    } UNLOCK(&mq->mut);
+    if (++mt->last == mt->n) mt->last = 0;
+    t = next;
   }
-  return -1;
+  mt->sub = mt->subtail = NULL;
+  mt->nbsub = 0;
+  LOCK(&mt->wmut)
+  {
+    mt->ntasks += k;
+    if (k == 1)
+      pthread_cond_signal(&mt->wcond);
+    else
+      pthread_cond_broadcast(&mt->wcond);
+  } UNLOCK(&mt->wmut);
+}
+
+/* move the output list to mt->out */
+static void
+mt_queue_collect(struct mt_pstate *mt)
+{
+  mt->out = mt->done;
+  mt->done = mt->donetail = NULL;
 }
 
 static GEN
 mtpthread_queue_get(struct mt_state *junk, long *workid, long *pending)
 {
   struct mt_pstate *mt = pari_mt;
-  struct mt_queue *mq;
-  GEN done = NULL;
-  long last;
+  struct mt_task *t;
+  GEN done;
   (void) junk;
-  if (mt->nbint<mt->n)
+  if (!mt->out)
   {
-    mt->last = mt->nbint;
-    *pending = mt->pending;
-    return NULL;
+    LOCK(&mt->pmut) { mt_queue_collect(mt); } UNLOCK(&mt->pmut);
   }
-  BLOCK_SIGINT_START
-  LOCK(&mt->pmut)
+  if (!mt->out)
   {
-    while ((last = mt_queue_check(mt)) < 0)
+    if (!mt->pending || (!mt->nomore && mt->pending < MT_DEPTH*mt->n))
     {
-      pthread_cond_wait(&mt->pcond, &mt->pmut);
-      if (PARI_SIGINT_pending)
-      {
-        int sig = PARI_SIGINT_pending;
-        PARI_SIGINT_pending = 0;
-        pthread_mutex_unlock(&mt->pmut);
-        PARI_SIGINT_block = 0;
-        raise(sig);
-        PARI_SIGINT_block = 1;
-        pthread_mutex_lock(&mt->pmut);
-      }
+      *pending = mt->pending;
+      return NULL;
     }
-  } UNLOCK(&mt->pmut);
-  BLOCK_SIGINT_END
-  mq = mt->mq+last;
-  if (mq->output==err_e_STACK) pari_err(e_STACKTHREAD);
-  done = gcopy(mq->output);
-  mq->output = NULL;
-  if (workid) *workid = mq->workid;
-  if (typ(done)==t_ERROR) pari_err(0,done);
-  mt->last = last;
+    BLOCK_SIGINT_START
+    mt_queue_flush(mt);
+    for(;;)
+    { /* a thread running a nested section may be cancelled while waiting */
+      int sig = 0;
+      pthread_mutex_lock(&mt->pmut);
+      pthread_cleanup_push(mt_queue_unlock, &mt->pmut);
+      while (!mt->done && !(sig = PARI_SIGINT_pending))
+        pthread_cond_wait(&mt->pcond, &mt->pmut);
+      if (!sig) mt_queue_collect(mt);
+      pthread_cleanup_pop(1);
+      if (!sig) break;
+      PARI_SIGINT_pending = 0;
+      PARI_SIGINT_block = 0;
+      raise(sig);
+      PARI_SIGINT_block = 1;
+    }
+    BLOCK_SIGINT_END
+  }
+  t = mt->out; mt->out = t->next;
+  done = t->bin? bin_copy(t->bin): NULL;
+  if (t->err)
+  { /* leave pending > 0: the thread which failed must be joined */
+    pari_free(t);
+    if (!done) pari_err(e_STACKTHREAD);
+    pari_err(0,done);
+  }
   mt->pending--;
   *pending = mt->pending;
+  if (workid) *workid = t->workid;
+  pari_free(t);
   return done;
 }
 
@@ -222,104 +366,290 @@ static void
 mtpthread_queue_submit(struct mt_state *junk, long workid, GEN work)
 {
   struct mt_pstate *mt = pari_mt;
-  struct mt_queue *mq = mt->mq+mt->last;
+  struct mt_task *t;
   (void) junk;
-  if (!work) { mt->nbint=mt->n; return; }
+  if (!work) { mt->nomore = 1; return; }
+  mt->nomore = 0;
   BLOCK_SIGINT_START
-  if (mt->nbint<mt->n)
-  {
-    mt->nbint++;
-    LOCK(mq->pmut)
-    {
-      while(!mq->avma)
-        pthread_cond_wait(mq->pcond, mq->pmut);
-    } UNLOCK(mq->pmut);
-  }
-  LOCK(&mq->mut)
-  {
-    mq->output = NULL;
-    mq->workid = workid;
-    mq->input = gcopy_avma(work, &mq->avma);
-    pthread_cond_signal(&mq->cond);
-  } UNLOCK(&mq->mut);
+  t = (struct mt_task *) pari_malloc(sizeof(struct mt_task));
+  t->workid = workid;
+  t->err = 0;
+  t->bin = mt->nshare? copy_bin_ref(work, mt->shareR, mt->nshare)
+                      : copy_bin(work);
+  t->next = NULL;
+  if (mt->subtail) mt->subtail->next = t; else mt->sub = t;
+  mt->subtail = t;
   mt->pending++;
+  if (++mt->nbsub >= mt->n) mt_queue_flush(mt);
   BLOCK_SIGINT_END
 }
 
+static void
+mt_task_free(struct mt_task *t)
+{
+  while (t)
+  {
+    struct mt_task *next = t->next;
+    if (t->bin) pari_free(t->bin);
+    pari_free(t); t = next;
+  }
+}
+
+/* Terminate the threads which are still working: the others are kept for
+ * the next parallel section, unless it is a nested one */
 void
 mt_queue_reset(void)
 {
   struct mt_pstate *mt = pari_mt;
+  int nested = mt != mt_pool, cs;
+  size_t hwm;
   long i;
   BLOCK_SIGINT_START
+  pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cs);
+  LOCK(&mt->wmut)
+  {
+    mt->ntasks = 0;
+    /* if all outputs were read, busy threads are only going back to sleep */
+    for (i=0; i<mt->n; i++)
+      mt->mq[i].cancel = nested? mt->mq[i].alive
+                               : mt->pending && mt->mq[i].busy;
+  } UNLOCK(&mt->wmut);
   for (i=0; i<mt->n; i++)
-    pthread_cancel(mt->th[i]);
+    if (mt->mq[i].cancel) pthread_cancel(mt->th[i]);
   for (i=0; i<mt->n; i++)
-    pthread_join(mt->th[i],NULL);
-  pari_mt = NULL;
+  {
+    struct mt_queue *mq = mt->mq+i;
+    if (mq->cancel)
+    {
+      pthread_join(mt->th[i],NULL);
+      mq->busy = 0;
+      mq->alive = 0;
+      if (DEBUGLEVEL && !nested) pari_warn(warner,"stop thread %ld",i);
+    }
+  }
+  /* a thread may steal from any deque until it is joined */
+  for (i=0; i<mt->n; i++)
+  {
+    struct mt_queue *mq = mt->mq+i;
+    if (mq->cancel && mq->task) { mt_task_free(mq->task); mq->task = NULL; }
+    mt_task_free(mq->head);
+    mq->head = mq->tail = NULL;
+  }
+  mt_task_free(mt->sub);
+  mt_task_free(mt->out);
+  mt_task_free(mt->done);
+  mt->sub = mt->subtail = mt->out = mt->done = mt->donetail = NULL;
+  if (mt->nshare)
+  { /* no thread can access them anymore */
+    for (i=0; i<mt->nshare; i++) gunclone(mt->share[i]);
+    pari_free(mt->share); pari_free(mt->shareR);
+    mt->share = NULL; mt->shareR = NULL; mt->nshare = 0;
+  }
+  pari_mt = mt->prev;
+  LOCK(&mt->pmut) { hwm = mt->hwm; } UNLOCK(&mt->pmut);
+  pthread_mutex_lock(&mt_nmut);
+  if (hwm > mt_hwm) mt_hwm = hwm;
+  if (nested) mt_nested -= mt->n;
+  pthread_mutex_unlock(&mt_nmut);
+  if (nested) mt_pool_free(mt);
+  pthread_setcancelstate(cs, NULL);
+  BLOCK_SIGINT_END
+}
+
+static void
+mt_pool_free(struct mt_pstate *mt)
+{
+  long i;
+  BLOCK_SIGINT_START
+  for (i=0; i<mt->n; i++)
+    if (mt->mq[i].alive) pthread_cancel(mt->th[i]);
+  for (i=0; i<mt->n; i++)
+    if (mt->mq[i].alive) pthread_join(mt->th[i],NULL);
   BLOCK_SIGINT_END
-  if (DEBUGLEVEL) pari_warn(warner,"stop threads");
+  if (DEBUGLEVEL && mt == mt_pool) pari_warn(warner,"stop threads");
   for (i=0;i<mt->n;i++)
   {
-    struct mt_queue *mq = mt->mq+i;
-    pthread_cond_destroy(&mq->cond);
-    pthread_mutex_destroy(&mq->mut);
+    pthread_mutex_destroy(&mt->mq[i].mut);
     pari_thread_free(&mt->pth[i]);
   }
+  pthread_cond_destroy(&mt->pcond);
+  pthread_mutex_destroy(&mt->pmut);
+  pthread_cond_destroy(&mt->wcond);
+  pthread_mutex_destroy(&mt->wmut);
   pari_free(mt->mq);
   pari_free(mt->pth);
   pari_free(mt->th);
   pari_free(mt);
 }
 
+static struct mt_pstate *
+mt_pool_alloc(long NBT, size_t size, size_t sizemax)
+{
+  struct mt_pstate *mt =
+         (struct mt_pstate*) pari_malloc(sizeof(struct mt_pstate));
+  long i;
+  mt->mq  = (struct mt_queue *) pari_malloc(sizeof(*mt->mq)*NBT);
+  mt->th  = (pthread_t *) pari_malloc(sizeof(*mt->th)*NBT);
+  mt->pth = (struct pari_thread *) pari_malloc(sizeof(*mt->pth)*NBT);
+  mt->n = NBT;
+  mt->size = size;
+  mt->sizemax = sizemax;
+  mt->hwm = 0;
+  mt->last = 0;
+  mt->ntasks = 0;
+  mt->sub = mt->subtail = mt->out = mt->done = mt->donetail = NULL;
+  mt->share = NULL; mt->shareR = NULL; mt->nshare = 0;
+  pthread_cond_init(&mt->pcond,NULL);
+  pthread_mutex_init(&mt->pmut,NULL);
+  pthread_cond_init(&mt->wcond,NULL);
+  pthread_mutex_init(&mt->wmut,NULL);
+  for (i=0;i<NBT;i++)
+  {
+    struct mt_queue *mq = mt->mq+i;
+    mq->no     = i;
+    mq->alive  = 0;
+    mq->resync = 0;
+    mq->busy   = 0;
+    mq->head   = mq->tail = mq->task = NULL;
+    mq->mt     = mt;
+    pthread_mutex_init(&mq->mut,NULL);
+    if (sizemax)
+      pari_thread_valloc(&mt->pth[i],size,sizemax,(GEN)mq);
+    else
+      pari_thread_alloc(&mt->pth[i],size,(GEN)mq);
+  }
+  return mt;
+}
+
+/* Threads must not catch signals meant for the main thread: block them
+ * while the threads are created, so that they inherit the mask */
+static void
+mt_pool_start(struct mt_pstate *mt)
+{
+  long i;
+#if !defined(_WIN32)
+  sigset_t set, oset;
+  sigemptyset(&set);
+#ifdef SIGINT
+  sigaddset(&set, SIGINT);
+#endif
+#ifdef SIGALRM
+  sigaddset(&set, SIGALRM);
+#endif
+  pthread_sigmask(SIG_BLOCK, &set, &oset);
+#endif
+  for (i=0;i<mt->n;i++)
+  {
+    struct mt_queue *mq = mt->mq+i;
+    if (mq->alive) continue;
+    pthread_create(&mt->th[i],NULL, &mt_queue_run, (void*)&mt->pth[i]);
+    mq->alive = 1;
+  }
+#if !defined(_WIN32)
+  pthread_sigmask(SIG_SETMASK, &oset, NULL);
+#endif
+}
+
+/* Number of threads for a nested section: share the idle pool threads among
+ * the busy ones, counting the caller which will wait for the results */
+static long
+mt_nested_size(void)
+{
+  long i, n, idle, busy = 0;
+  if (!mt_pool) return 1;
+  for (i=0; i<mt_pool->n; i++) busy += mt_pool->mq[i].busy;
+  pthread_mutex_lock(&mt_nmut);
+  idle = mt_pool->n - busy - mt_nested;
+  n = idle > 0? 1 + idle / maxss(busy, 1): 1;
+  n = minss(n, pari_mt_nbthreads);
+  if (n > 1) mt_nested += n;
+  pthread_mutex_unlock(&mt_nmut);
+  return n;
+}
+
+static void
+mt_queue_init(struct pari_mt *pt, struct mt_pstate *mt, GEN worker)
+{
+  mt->worker = worker;
+  mt->pending = 0;
+  mt->nbsub = 0;
+  mt->nomore = 0;
+  mt->prev = pari_mt;
+  mt->depth = pari_mt? pari_mt->depth+1: 1;
+  pari_mt = mt;
+  pt->get=&mtpthread_queue_get;
+  pt->submit=&mtpthread_queue_submit;
+  pt->end=&mt_queue_reset;
+}
+
+/* largest stack high-water mark of the threads, over all parallel sections */
+ulong
+mt_stack_hwm(void)
+{
+  size_t hwm;
+  pthread_mutex_lock(&mt_nmut); hwm = mt_hwm; pthread_mutex_unlock(&mt_nmut);
+  return hwm;
+}
+
+/* The components of x are given to the threads by reference instead of
+ * being copied in each task: x is cloned (unless it is already a clone of
+ * ours) and kept until the end of the section. The threads must treat
+ * these components as read-only, as GP functions do with their arguments. */
+GEN
+mt_queue_share(struct pari_mt *pt, GEN x)
+{
+  struct mt_pstate *mt = pari_mt;
+  long n;
+  if (pt->submit != &mtpthread_queue_submit) return x;
+  BLOCK_SIGINT_START
+  /* a clone of another thread must not have its refcount changed here */
+  x = mt_is_thread()? gclone(x): gcloneref(x);
+  n = mt->nshare++;
+  mt->share = (GEN*) pari_realloc(mt->share, (n+1)*sizeof(GEN));
+  mt->shareR = (pari_sp*) pari_realloc(mt->shareR, 2*(n+1)*sizeof(pari_sp));
+  mt->shareR[2*n] = (pari_sp)x;
+  mt->shareR[2*n+1] = (pari_sp)(x + (typ(x)==t_LIST? 3: gsizeword(x)));
+  mt->share[n] = x;
+  BLOCK_SIGINT_END
+  return x;
+}
+
 void
 mt_queue_start(struct pari_mt *pt, GEN worker)
 {
-  if (pari_mt)
-    mtsingle_queue_start(pt, worker);
+  if (pari_mt || mt_is_thread())
+  { /* nested section: the global state was synced by the outer one */
+    long n = mt_nested_size();
+    struct mt_pstate *mt;
+    if (n < 2) { mtsingle_queue_start(pt, worker); return; }
+    BLOCK_SIGINT_START
+    mt = mt_pool_alloc(n, mt_pool->size, mt_pool->sizemax);
+    mt_pool_start(mt);
+    mt_queue_init(pt, mt, worker);
+    BLOCK_SIGINT_END
+  }
   else
   {
     long NBT = pari_mt_nbthreads;
-    struct mt_pstate *mt =
-           (struct mt_pstate*) pari_malloc(sizeof(struct mt_pstate));
-    long mtparisize = GP_DATA->threadsize? GP_DATA->threadsize: pari_mainstack->rsize;
-    long mtparisizemax = GP_DATA->threadsizemax;
-    long i;
-    mt->mq  = (struct mt_queue *) pari_malloc(sizeof(*mt->mq)*NBT);
-    mt->th  = (pthread_t *) pari_malloc(sizeof(*mt->th)*NBT);
-    mt->pth = (struct pari_thread *) pari_malloc(sizeof(*mt->pth)*NBT);
-    mt->pending = 0;
-    mt->n = NBT;
-    mt->nbint = 0;
-    mt->last = 0;
-    pthread_cond_init(&mt->pcond,NULL);
-    pthread_mutex_init(&mt->pmut,NULL);
+    size_t mtparisize = GP_DATA->threadsize? GP_DATA->threadsize: pari_mainstack->rsize;
+    size_t mtparisizemax = pari_thread_vsize(mtparisize);
+    struct mt_pstate *mt = mt_pool;
+    long i, nbnew = 0;
+    if (mt && (mt->n != NBT || mt->size != mtparisize
+                            || mt->sizemax != mtparisizemax))
+    { mt_pool_free(mt); mt = NULL; }
+    if (!mt) mt = mt_pool = mt_pool_alloc(NBT, mtparisize, mtparisizemax);
     pari_thread_sync();
     for (i=0;i<NBT;i++)
     {
       struct mt_queue *mq = mt->mq+i;
-      mq->no     = i;
-      mq->avma   = 0;
-      mq->worker = worker;
-      mq->input  = NULL;
-      mq->output = NULL;
-      mq->pcond  = &mt->pcond;
-      mq->pmut   = &mt->pmut;
-      pthread_cond_init(&mq->cond,NULL);
-      pthread_mutex_init(&mq->mut,NULL);
-      if (mtparisizemax)
-        pari_thread_valloc(&mt->pth[i],mtparisize,mtparisizemax,(GEN)mq);
-      else
-        pari_thread_alloc(&mt->pth[i],mtparisize,(GEN)mq);
+      if (mq->alive) mq->resync = 1;
+      else { mq->resync = 0; nbnew++; }
     }
-    if (DEBUGLEVEL) pari_warn(warner,"start threads");
+    if (DEBUGLEVEL && nbnew) pari_warn(warner,"start threads");
     BLOCK_SIGINT_START
-    for (i=0;i<NBT;i++)
-      pthread_create(&mt->th[i],NULL, &mt_queue_run, (void*)&mt->pth[i]);
-    pari_mt = mt;
+    mt_pool_start(mt);
+    mt_queue_init(pt, mt, worker);
     BLOCK_SIGINT_END
-    pt->get=&mtpthread_queue_get;
-    pt->submit=&mtpthread_queue_submit;
-    pt->end=&mt_queue_reset;
   }
 }
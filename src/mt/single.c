@@ -20,6 +20,8 @@ void mt_err_recover(long er) { (void)er; }
 void pari_mt_close(void) { }
 void mt_queue_reset(void) { }
 void mt_broadcast(GEN code) {(void) code;}
+void mt_lock(void) { }
+void mt_unlock(void) { }
 
 void
 mt_sigint(void) {}
@@ -47,3 +49,11 @@ mt_queue_start(struct pari_mt *pt, GEN worker)
 {
   mtsingle_queue_start(pt, worker);
 }
+
+/* the tasks are run in place */
+GEN
+mt_queue_share(struct pari_mt *pt, GEN x) { (void)pt; return x; }
+
+/* no thread stacks */
+ulong
+mt_stack_hwm(void) { return 0; }
@@ -19,7 +19,7 @@ void specinit()
   long size = 100000L;
   pari_mainstack = malloc(sizeof(*pari_mainstack));
   pari_mainstack->size = size;
-  pari_mainstack->bot = (pari_sp)malloc(size);
+  pari_mainstack->lim = pari_mainstack->bot = (pari_sp)malloc(size);
   pari_mainstack->top = avma = pari_mainstack->bot + size;
   gen_0 = cgeti(2); affui(0, gen_0);
   gen_1 = utoipos(1);
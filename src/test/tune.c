@@ -263,6 +263,18 @@ dftmod(speed_param *s)
   return speed_endtime();                \
 }
 
+/* same, measuring wall-clock time: for multithreaded algorithms */
+#define WALLTIME_FUN(call) {\
+  {                                      \
+    GEN T0 = getwalltime();              \
+    pari_sp av = avma;                   \
+    int i;                               \
+    i = (s)->reps;                       \
+    do { call; avma = av; } while (--i); \
+    return itos(subii(getwalltime(), T0)) / 1000.; \
+  }                                      \
+}
+
 #define m_menable(s,var,min) (*(s->var)=minss(lg(s->x)-2,s->min))
 #define  m_enable(s,var) (*(s->var)=lg(s->x)-2)/* enable  asymptotically fastest */
 #define m_disable(s,var) (*(s->var)=lg(s->x)+1)/* disable asymptotically fastest */
@@ -287,6 +299,23 @@ static double speed_mulrr(speed_param *s)
 static double speed_mulii(speed_param *s)
 { TIME_FUN(mulii(s->x, s->y)); }
 
+static double speed_mulii_mt(speed_param *s)
+{ WALLTIME_FUN(mulii(s->x, s->y)); }
+
+/* s->size digits in base 10^19 (10^9 for 32-bit), as used by the gp reader */
+static double speed_fromdigitsu_mt(speed_param *s)
+{
+#ifdef LONG_IS_64BIT
+  ulong b = 10000000000000000000UL;
+#else
+  ulong b = 1000000000UL;
+#endif
+  long i, l = lgefint(s->x)-2;
+  GEN B = utoipos(b), v = cgetg(l+1, t_VECSMALL);
+  for (i = 1; i <= l; i++) uel(v,i) = uel(s->x,i+1) % b;
+  WALLTIME_FUN(fromdigitsu(v, B));
+}
+
 static double speed_exp(speed_param *s)
 { TIME_FUN(mpexp(s->x)); }
 
@@ -356,6 +385,12 @@ static double speed_Flx_gcd(speed_param *s)
 static double speed_Flx_extgcd(speed_param *s)
 { GEN u,v; TIME_FUN(Flx_extgcd(s->x, s->y, s->l, &u, &v)); }
 
+static double speed_Flx_multieval(speed_param *s)
+{
+  GEN x = Flx_to_Flv(s->y, lgpol(s->y));
+  TIME_FUN(Flx_Flv_multieval(s->x, x, s->l));
+}
+
 static double speed_FpX_inv(speed_param *s)
 { TIME_FUN(FpX_invBarrett(s->x, s->p)); }
 
@@ -383,6 +418,11 @@ static double speed_FpX_gcd(speed_param *s)
 { TIME_FUN(FpX_gcd(s->x, s->y, s->p)); }
 static double speed_FpX_extgcd(speed_param *s)
 { GEN u,v; TIME_FUN(FpX_extgcd(s->x, s->y, s->p, &u, &v)); }
+static double speed_FpX_multieval(speed_param *s)
+{
+  GEN x = RgX_to_RgC(s->y, lgpol(s->y));
+  TIME_FUN(FpX_FpV_multieval(s->x, x, s->p));
+}
 
 static double speed_FlxqX_inv(speed_param *s)
 { TIME_FUN(FlxqX_invBarrett(s->x, s->T, s->l)); }
@@ -445,6 +485,12 @@ static double speed_FpXQX_extgcd(speed_param *s)
 static double speed_FpXQX_gcd(speed_param *s)
 { TIME_FUN(FpXQX_gcd(s->x, s->y, s->T, s->p)); }
 
+static double speed_FpXQX_multieval(speed_param *s)
+{
+  GEN x = RgX_to_RgC(s->y, lgpol(s->y));
+  TIME_FUN(FpXQX_FpXQV_multieval(s->x, x, s->T, s->p));
+}
+
 /* small coeffs: earlier thresholds for more complicated rings */
 static double speed_RgX_sqr(speed_param *s)
 { TIME_FUN(RgX_sqr(s->x)); }
@@ -466,6 +512,8 @@ static tune_param param[] = {
 {PARI,var(SQRI_KARATSUBA_LIMIT),   t_INT, 4,0, speed_sqri,0,0,&SQRI_FFT_LIMIT},
 {PARI,var(MULII_FFT_LIMIT),        t_INT, 500,0, speed_mulii,0.02},
 {PARI,var(SQRI_FFT_LIMIT),         t_INT, 500,0, speed_sqri,0.02},
+{PARI,var(MULII_FFT_PARALLEL_LIMIT),t_INT,2000,200000, speed_mulii_mt,0.05},
+{0,   var(FROMDIGITS_PARALLEL_LIMIT),t_INT,2000,200000, speed_fromdigitsu_mt,0.05},
 {0,   var(MULRR_MULII_LIMIT),      t_REAL,4,0, speed_mulrr},
 {0,   var(Fp_POW_REDC_LIMIT),      t_INT, 3,100, speed_Fp_pow,0,0,&Fp_POW_BARRETT_LIMIT},
 {0,   var(Fp_POW_BARRETT_LIMIT),   t_INT, 3,0, speed_Fp_pow},
@@ -521,6 +569,7 @@ static tune_param param[] = {
             speed_Flx_halfgcd,0,0,NULL,&Flx_MUL_MULII2_LIMIT},
 {0,  var(Flx_GCD_LIMIT),           t_Flx,10,0, speed_Flx_gcd,0.1},
 {0,  var(Flx_EXTGCD_LIMIT),        t_Flx,10,0, speed_Flx_extgcd},
+{0,  var(Flx_MULTIEVAL_LIMIT),     t_Flx,5,0, speed_Flx_multieval,0.05},
 {0,  var(FlxqX_INVBARRETT_LIMIT),t_NFlxqX,10,0, speed_FlxqX_inv,0.05},
 {0,  var(FlxqX_BARRETT_LIMIT),   t_NFlxqX,10,0, speed_FlxqXQ_red,0.05},
 {0,  var(FlxqX_DIVREM_BARRETT_LIMIT), t_NFlxqX,10,0, speed_FlxqX_divrem,0.05},
@@ -535,6 +584,7 @@ static tune_param param[] = {
 {0,  var(FpX_HALFGCD_LIMIT),       t_FpX,10,0, speed_FpX_halfgcd},
 {0,  var(FpX_GCD_LIMIT),           t_FpX,10,0, speed_FpX_gcd,0.1},
 {0,  var(FpX_EXTGCD_LIMIT),        t_FpX,10,0, speed_FpX_extgcd},
+{0,  var(FpX_MULTIEVAL_LIMIT),     t_FpX,5,0, speed_FpX_multieval,0.05},
 {0,  var(FpXQX_INVBARRETT_LIMIT),t_NFpXQX,10,0, speed_FpXQX_inv,0.05},
 {0,  var(FpXQX_BARRETT_LIMIT),   t_NFpXQX,10,0, speed_FpXQXQ_red,0.05},
 {0,  var(FpXQX_DIVREM_BARRETT_LIMIT), t_NFpXQX,10,0, speed_FpXQX_divrem,0.05},
@@ -542,6 +592,7 @@ static tune_param param[] = {
 {0,  var(FpXQX_HALFGCD_LIMIT),    t_FpXQX,10,0, speed_FpXQX_halfgcd,0.05},
 {0,  var(FpXQX_GCD_LIMIT),        t_FpXQX,10,0, speed_FpXQX_gcd,0.05},
 {0,  var(FpXQX_EXTGCD_LIMIT),     t_FpXQX,10,0, speed_FpXQX_extgcd,0.05},
+{0,  var(FpXQX_MULTIEVAL_LIMIT),  t_FpXQX,5,0, speed_FpXQX_multieval,0.05},
 {0,  var(RgX_MUL_LIMIT),           t_FpX, 4,0, speed_RgX_mul},
 {0,  var(RgX_SQR_LIMIT),           t_FpX, 4,0, speed_RgX_sqr},
 };